@@ -0,0 +1,236 @@
+#include "../Driver/solvers.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <exception>
+#include <filesystem>
+#include <iostream>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "../Common/cache.h"
+#include "../Common/cli.h"
+#include "../Common/crash.h"
+#include "../Common/input.h"
+#include "../Common/json.h"
+#include "../Common/log.h"
+#include "../Common/solver.h"
+#include "../Common/tasks.h"
+
+// Usage: batch [--threads <n>] [--cache <directory>] <day> <input directory or manifest>
+// Solves every input of one day (every regular file of the directory, or every line of the manifest,
+// relative to the manifest's directory, '#' starts a comment) concurrently on the task pool. Each result
+// is written to stdout as one JSON line as soon as it is done, so the order follows completion; the
+// solvers' own console output is discarded. A malformed input only fails its own run, which is reported
+// with an "error" instead of the answers.
+// With --cache, inputs solved by an earlier batch are answered from the cache and marked "cached".
+
+constexpr std::string_view usage = "Usage: batch [--threads <n>] [--cache <directory>] <day> <input directory or manifest>";
+
+struct Scratch {
+	std::string Input;
+	std::string Output;
+};
+
+// Every worker keeps its buffers between inputs, so after the first few files reading and formatting
+// stop allocating.
+thread_local Scratch threadScratch;
+
+std::vector<std::filesystem::path> findInputs(std::filesystem::path const& source) {
+	std::vector<std::filesystem::path> inputs;
+
+	if(std::filesystem::is_directory(source)) {
+		for(auto const& entry : std::filesystem::directory_iterator(source)) {
+			if(entry.is_regular_file()) {
+				inputs.emplace_back(entry.path());
+			}
+		}
+
+		std::sort(inputs.begin(), inputs.end());
+
+		return inputs;
+	}
+
+	aoc::MappedFile manifest(source.string());
+
+	for(auto line : aoc::splitLines(manifest.Data())) {
+		line = line.substr(0, line.find('#'));
+
+		while(!line.empty() && (line.back() == ' ' || line.back() == '\t')) {
+			line.remove_suffix(1);
+		}
+
+		if(!line.empty()) {
+			inputs.emplace_back(source.parent_path() / line);
+		}
+	}
+
+	return inputs;
+}
+
+bool readFile(std::filesystem::path const& path, std::string& buffer) {
+	std::FILE* const file = std::fopen(path.string().c_str(), "rb");
+
+	if(!file) {
+		return false;
+	}
+
+	buffer.clear();
+
+	char chunk[1 << 16];
+
+	for(std::size_t size; (size = std::fread(chunk, 1, sizeof(chunk), file)) > 0;) {
+		buffer.append(chunk, size);
+	}
+
+	bool const isRead = !std::ferror(file);
+	std::fclose(file);
+
+	return isRead;
+}
+
+void appendAnswer(std::string& output, aoc::Answer const& answer) {
+	if(std::holds_alternative<std::monostate>(answer)) {
+		output += "null";
+	}
+	else {
+		aoc::appendJsonString(output, aoc::toString(answer));
+	}
+}
+
+int main(int argc, char** argv) {
+	std::vector<std::string_view> const args(argv + 1, argv + argc);
+	std::vector<std::string_view> positional;
+	std::optional<aoc::ResultCache> cache;
+
+	for(std::size_t i = 0; i < args.size(); ++i) {
+		if(args[i] == "--threads") {
+			auto const threads = aoc::parseThreadCount(i + 1 < args.size() ? args[++i] : std::string_view());
+
+			[[unlikely]]
+			if(!threads) {
+				return aoc::failUsage(usage, "--threads expects a positive number");
+			}
+
+			aoc::setThreadCount(*threads);
+		}
+		else if(args[i] == "--cache") {
+			[[unlikely]]
+			if(i + 1 >= args.size()) {
+				return aoc::failUsage(usage, "--cache expects a directory");
+			}
+
+			cache.emplace(std::string(args[++i]));
+		}
+		else {
+			positional.emplace_back(args[i]);
+		}
+	}
+
+	[[unlikely]]
+	if(positional.size() != 2) {
+		return aoc::failUsage(usage, "Expected a day and an input directory or manifest");
+	}
+
+	auto const solvers = aoc::selectSolvers(positional[0]);
+
+	[[unlikely]]
+	if(solvers.empty()) {
+		return aoc::failUsage(usage, "Unknown day " + std::string(positional[0]));
+	}
+
+	std::filesystem::path const source(positional[1]);
+
+	[[unlikely]]
+	if(!std::filesystem::exists(source)) {
+		return aoc::failUsage(usage, "No input directory or manifest at " + source.string());
+	}
+
+	auto const inputs = findInputs(source);
+	auto const jobCount = (long long)(inputs.size() * solvers.size());
+
+	std::mutex outputMutex;
+	std::atomic<long long> failures{ 0 };
+
+	aoc::makeFailuresRecoverable();
+	aoc::discardLogs();
+
+	auto const start = std::chrono::steady_clock::now();
+
+	aoc::parallelFor(0, jobCount, [&](long long job) {
+		auto const& input = inputs[std::size_t(job) / solvers.size()];
+		auto const& solver = *solvers[std::size_t(job) % solvers.size()];
+
+		// A parallel solver that waits for its tasks may run another job on this thread meanwhile, so the
+		// buffers are taken out while they are in use instead of being shared with that job.
+		Scratch scratch = std::exchange(threadScratch, {});
+		auto& output = scratch.Output;
+
+		output.clear();
+		output += "{\"day\": \"";
+		output += solver.Id;
+		output += "\", \"input\": ";
+		aoc::appendJsonString(output, input.string());
+
+		if(readFile(input, scratch.Input)) {
+			try {
+				auto const solveStart = std::chrono::steady_clock::now();
+				auto cached = cache ? cache->Find(solver, scratch.Input) : std::nullopt;
+				bool const isCached = cached.has_value();
+
+				if(!isCached) {
+					cached = solver.Solve(scratch.Input);
+
+					if(cache) {
+						cache->Store(solver, scratch.Input, *cached);
+					}
+				}
+
+				auto const& answers = *cached;
+				auto const ns = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - solveStart).count();
+
+				output += ", \"part1\": ";
+				appendAnswer(output, answers.Part1);
+				output += ", \"part2\": ";
+				appendAnswer(output, answers.Part2);
+				output += ", \"ns\": ";
+				output += std::to_string(ns);
+
+				if(isCached) {
+					output += ", \"cached\": true";
+				}
+			}
+			catch(std::exception const& error) {
+				failures.fetch_add(1, std::memory_order_relaxed);
+				output += ", \"error\": ";
+				aoc::appendJsonString(output, error.what());
+			}
+		}
+		else {
+			failures.fetch_add(1, std::memory_order_relaxed);
+			output += ", \"error\": \"could not read the input\"";
+		}
+
+		output += "}\n";
+
+		{
+			std::lock_guard lock(outputMutex);
+			std::fwrite(output.data(), 1, output.size(), stdout);
+			std::fflush(stdout);
+		}
+
+		threadScratch = std::move(scratch);
+	}, 1);
+
+	auto const elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+	std::cerr << jobCount << " runs on " << aoc::TaskPool::Get().GetThreadCount() << " threads in " << elapsed << " s, " << failures.load() << " failed\n";
+
+	return failures.load() == 0 ? 0 : 1;
+}
@@ -0,0 +1,412 @@
+#include "../Driver/solvers.h"
+
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <chrono>
+#include <cmath>
+#include <filesystem>
+#include <iostream>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "../Common/allocations.h"
+#include "../Common/cli.h"
+#include "../Common/crash.h"
+#include "../Common/input.h"
+#include "../Common/json.h"
+#include "../Common/log.h"
+#include "../Common/solver.h"
+#include "../Common/tasks.h"
+
+// Usage: benchmark [--root <repository root>] [--runs <n>] [--warmup <n>] [--threads <n>]
+//                  [--fixture <name>]... [<day>[=<input file>]...]
+// Every *.txt next to a solver is a fixture (tiny, larger, primitive, input, ...); --fixture keeps only
+// the ones whose name starts with <name>. An explicit input file (e.g. from the generator) replaces them.
+// The report goes to stdout as JSON, anything the solvers print while they are timed is discarded.
+// Every run is split into the phases the solver marks (parse, solve, combine). Peak RSS per phase is always
+// reported; build with AOC_TRACK_ALLOCATIONS=1 to also count allocations, bytes and the peak live heap,
+// the huge page tables of PageArray included.
+
+// Fixtures the solvers cannot answer: the Day15 example asks about row 10 inside a 20x20 area while the
+// solvers hardcode the puzzle's row and area, and the primitive Day21 example has no humn for part 2.
+constexpr std::array<std::pair<std::string_view, std::string_view>, 3> unsupportedFixtures{ {
+	{ "15a", "tiny.txt" },
+	{ "15b", "tiny.txt" },
+	{ "21ab", "primitive.txt" },
+} };
+
+// Fixtures only measured when --fixture asks for them: a single run of the Day19 example takes minutes,
+// which the default runs would repeat eleven times.
+constexpr std::array<std::pair<std::string_view, std::string_view>, 1> heavyFixtures{ {
+	{ "19ab", "tiny.txt" },
+} };
+
+struct Percentiles {
+	long long Min{};
+	long long P50{};
+	long long P99{};
+};
+
+struct PhaseMemory {
+	long long Allocations{};
+	long long Bytes{};
+	long long PeakHeapBytes{};
+	long long PeakRss{};
+};
+
+struct Measurement {
+	std::string_view Day;
+	std::string Fixture;
+	std::size_t Bytes{};
+	std::array<bool, aoc::phaseNames.size()> HasPhase{};
+	std::array<Percentiles, aoc::phaseNames.size()> PhaseTimes{};
+	Percentiles Total{};
+	// of the last measured run, allocations are deterministic enough that one run tells the story
+	std::array<PhaseMemory, aoc::phaseNames.size()> Memory{};
+};
+
+struct PhaseBoundary {
+	aoc::Phase Phase{};
+	std::chrono::steady_clock::time_point Time;
+	aoc::AllocationStats Allocations;
+	long long PeakRss{};
+};
+
+// Filled by the phase listener while a solver runs, the capacity is reserved up front so recording a
+// boundary never allocates inside the measured phases.
+thread_local std::vector<PhaseBoundary> boundaries;
+
+void recordBoundary(aoc::Phase phase) {
+	boundaries.emplace_back(PhaseBoundary{
+		.Phase = phase,
+		.Time = std::chrono::steady_clock::now(),
+		.Allocations = aoc::getAllocationStats(),
+		.PeakRss = aoc::getPeakRss(),
+	});
+
+	aoc::resetAllocationPeak();
+}
+
+// Nearest-rank percentiles, the samples get sorted in place.
+Percentiles getPercentiles(std::vector<long long>& samples) {
+	std::sort(samples.begin(), samples.end());
+
+	auto const rank = [&samples](double p) -> long long {
+		auto const idx = std::max(0, int(std::ceil(p * double(samples.size()))) - 1);
+		return samples[idx];
+	};
+
+	return { .Min = samples.front(), .P50 = rank(0.50), .P99 = rank(0.99) };
+}
+
+constexpr std::string_view usage =
+	"Usage: benchmark [--root <repository root>] [--runs <n>] [--warmup <n>] [--threads <n>]\n"
+	"                 [--fixture <name>]... [<day>[=<input file>]...]";
+
+std::optional<int> parseCount(std::string_view text, int minimum) {
+	int value{};
+	auto const [end, error] = std::from_chars(text.data(), text.data() + text.size(), value);
+
+	if(error != std::errc{} || end != text.data() + text.size() || value < minimum) {
+		return std::nullopt;
+	}
+
+	return value;
+}
+
+std::vector<std::filesystem::path> findFixtures(aoc::Solver const& solver, std::filesystem::path const& root, std::vector<std::string_view> const& prefixes) {
+	std::vector<std::filesystem::path> fixtures;
+
+	for(auto const& entry : std::filesystem::directory_iterator(root / solver.Directory)) {
+		auto const name = entry.path().filename().string();
+
+		if(!entry.is_regular_file() || entry.path().extension() != ".txt" || name == "out.txt") {
+			continue;
+		}
+
+		std::pair<std::string_view, std::string_view> const key(solver.Id, name);
+
+		auto const isUnsupported = std::find(unsupportedFixtures.begin(), unsupportedFixtures.end(), key) != unsupportedFixtures.end();
+		auto const isHeavy = std::find(heavyFixtures.begin(), heavyFixtures.end(), key) != heavyFixtures.end();
+
+		if(isUnsupported || (isHeavy && prefixes.empty())) {
+			continue;
+		}
+
+		auto const isSelected = prefixes.empty() || std::any_of(prefixes.begin(), prefixes.end(), [&name](auto prefix) {
+			return std::string_view(name).starts_with(prefix);
+		});
+
+		if(isSelected) {
+			fixtures.emplace_back(entry.path());
+		}
+	}
+
+	std::sort(fixtures.begin(), fixtures.end());
+
+	return fixtures;
+}
+
+Measurement measure(aoc::Solver const& solver, std::filesystem::path const& fixture, int runs, int warmup) {
+	aoc::MappedFile input(fixture.string());
+
+	Measurement measurement{
+		.Day = solver.Id,
+		.Fixture = fixture.filename().string(),
+		.Bytes = input.Data().size(),
+	};
+
+	std::array<std::vector<long long>, aoc::phaseNames.size()> phaseSamples;
+	std::vector<long long> totalSamples;
+
+	boundaries.reserve(16);
+
+	for(int run = -warmup; run < runs; ++run) {
+		boundaries.clear();
+
+		recordBoundary(aoc::Phase::Parse);
+		aoc::phaseListener = &recordBoundary;
+
+		solver.Solve(input.Data());
+
+		aoc::phaseListener = nullptr;
+		recordBoundary(aoc::Phase::Solve);
+
+		if(run < 0) {
+			continue;
+		}
+
+		auto const ns = [](auto duration) -> long long {
+			return std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count();
+		};
+
+		std::array<long long, aoc::phaseNames.size()> phaseNs{};
+
+		// without any boundary marked by the solver everything it did counts as solving
+		bool const isMarked = boundaries.size() > 2;
+
+		for(std::size_t i = 0; i + 1 < boundaries.size(); ++i) {
+			auto const phase = i == 0 && !isMarked ? aoc::Phase::Solve : boundaries[i].Phase;
+			auto const idx = std::size_t(phase);
+			auto const& from = boundaries[i];
+			auto const& to = boundaries[i + 1];
+
+			measurement.HasPhase[idx] = true;
+			phaseNs[idx] += ns(to.Time - from.Time);
+
+			if(run + 1 == runs) {
+				auto& memory = measurement.Memory[idx];
+
+				memory.Allocations += to.Allocations.Allocations - from.Allocations.Allocations;
+				memory.Bytes += to.Allocations.Bytes - from.Allocations.Bytes;
+				memory.PeakHeapBytes = std::max(memory.PeakHeapBytes, to.Allocations.PeakLiveBytes);
+				memory.PeakRss = std::max(memory.PeakRss, to.PeakRss);
+			}
+		}
+
+		for(std::size_t idx = 0; idx < phaseNs.size(); ++idx) {
+			phaseSamples[idx].emplace_back(phaseNs[idx]);
+		}
+
+		totalSamples.emplace_back(ns(boundaries.back().Time - boundaries.front().Time));
+	}
+
+	for(std::size_t idx = 0; idx < phaseSamples.size(); ++idx) {
+		measurement.PhaseTimes[idx] = getPercentiles(phaseSamples[idx]);
+	}
+
+	measurement.Total = getPercentiles(totalSamples);
+
+	return measurement;
+}
+
+void printPercentiles(std::string_view name, Percentiles const& percentiles) {
+	std::cout << "\t\t\t\"" << name << "\": { \"min\": " << percentiles.Min << ", \"p50\": " << percentiles.P50 << ", \"p99\": " << percentiles.P99 << " },\n";
+}
+
+void printMemory(Measurement const& measurement) {
+	std::cout << "\t\t\t\"memory\": {";
+
+	bool isFirst = true;
+
+	for(std::size_t idx = 0; idx < aoc::phaseNames.size(); ++idx) {
+		if(!measurement.HasPhase[idx]) {
+			continue;
+		}
+
+		auto const& memory = measurement.Memory[idx];
+
+		std::cout << (isFirst ? "\n" : ",\n") << "\t\t\t\t\"" << aoc::phaseNames[idx] << "\": { ";
+
+		if constexpr(aoc::isTrackingAllocations) {
+			std::cout << "\"allocations\": " << memory.Allocations << ", \"bytes\": " << memory.Bytes << ", \"peak_heap_bytes\": " << memory.PeakHeapBytes << ", ";
+		}
+
+		std::cout << "\"peak_rss_bytes\": " << memory.PeakRss << " }";
+
+		isFirst = false;
+	}
+
+	std::cout << "\n\t\t\t},\n";
+}
+
+void printMeasurement(Measurement const& measurement, bool isLast) {
+	// throughput of the median run over the whole input, parsing included
+	long long const bytesPerSecond = measurement.Total.P50 > 0 ? (long long)(double(measurement.Bytes) * 1e9 / double(measurement.Total.P50)) : 0;
+
+	std::string day;
+	aoc::appendJsonString(day, measurement.Day);
+
+	std::string fixture;
+	aoc::appendJsonString(fixture, measurement.Fixture);
+
+	std::cout << "\t\t{\n";
+	std::cout << "\t\t\t\"day\": " << day << ",\n";
+	std::cout << "\t\t\t\"fixture\": " << fixture << ",\n";
+	std::cout << "\t\t\t\"bytes\": " << measurement.Bytes << ",\n";
+	std::cout << "\t\t\t\"phases\": [";
+
+	bool isFirst = true;
+
+	for(std::size_t idx = 0; idx < aoc::phaseNames.size(); ++idx) {
+		if(measurement.HasPhase[idx]) {
+			std::cout << (isFirst ? "" : ", ") << '"' << aoc::phaseNames[idx] << '"';
+			isFirst = false;
+		}
+	}
+
+	std::cout << "],\n";
+
+	for(std::size_t idx = 0; idx < aoc::phaseNames.size(); ++idx) {
+		if(measurement.HasPhase[idx]) {
+			printPercentiles(std::string(aoc::phaseNames[idx]) + "_ns", measurement.PhaseTimes[idx]);
+		}
+	}
+
+	printPercentiles("total_ns", measurement.Total);
+	printMemory(measurement);
+	std::cout << "\t\t\t\"bytes_per_second\": " << bytesPerSecond << '\n';
+	std::cout << "\t\t}" << (isLast ? "" : ",") << '\n';
+}
+
+int main(int argc, char** argv) {
+	std::filesystem::path root = ".";
+	int runs = 10;
+	int warmup = 1;
+
+	std::vector<std::string_view> fixturePrefixes;
+	std::vector<std::pair<aoc::Solver const*, std::filesystem::path>> selected;
+
+	std::vector<std::string_view> const args(argv + 1, argv + argc);
+
+	// the report owns stdout, and the solvers' task pool workers may log while a solve is timed
+	aoc::discardLogs();
+
+	for(std::size_t i = 0; i < args.size(); ++i) {
+		auto const arg = args[i];
+
+		if(arg.starts_with("--")) {
+			[[unlikely]]
+			if(arg != "--root" && arg != "--runs" && arg != "--warmup" && arg != "--threads" && arg != "--fixture") {
+				return aoc::failUsage(usage, "Unknown option " + std::string(arg));
+			}
+
+			[[unlikely]]
+			if(i + 1 >= args.size()) {
+				return aoc::failUsage(usage, std::string(arg) + " expects a value");
+			}
+		}
+
+		if(arg == "--root") {
+			root = args[++i];
+		}
+		else if(arg == "--threads") {
+			auto const threads = aoc::parseThreadCount(args[++i]);
+
+			[[unlikely]]
+			if(!threads) {
+				return aoc::failUsage(usage, "--threads expects a positive number");
+			}
+
+			aoc::setThreadCount(*threads);
+		}
+		else if(arg == "--runs" || arg == "--warmup") {
+			int const minimum = arg == "--warmup" ? 0 : 1;
+			auto const value = args[++i];
+			auto const count = parseCount(value, minimum);
+
+			[[unlikely]]
+			if(!count) {
+				return aoc::failUsage(usage, std::string(arg) + " expects a number of at least " + std::to_string(minimum) + ", got " + std::string(value));
+			}
+
+			if(arg == "--runs") {
+				runs = *count;
+			}
+			else {
+				warmup = *count;
+			}
+		}
+		else if(arg == "--fixture") {
+			fixturePrefixes.emplace_back(args[++i]);
+		}
+		else {
+			auto const separator = arg.find('=');
+			auto const selector = arg.substr(0, separator);
+			auto const matching = aoc::selectSolvers(selector);
+
+			[[unlikely]]
+			if(matching.empty()) {
+				return aoc::failUsage(usage, "Unknown day " + std::string(selector));
+			}
+
+			for(auto const* solver : matching) {
+				selected.emplace_back(solver, separator == std::string_view::npos ? std::filesystem::path() : std::filesystem::path(arg.substr(separator + 1)));
+			}
+		}
+	}
+
+	if(selected.empty()) {
+		for(auto const& solver : aoc::solvers) {
+			selected.emplace_back(&solver, std::filesystem::path());
+		}
+	}
+
+	std::vector<Measurement> measurements;
+
+	for(auto const& [solver, path] : selected) {
+		[[unlikely]]
+		if(path.empty() ? !std::filesystem::is_directory(root / solver->Directory) : !std::filesystem::is_regular_file(path)) {
+			return aoc::failUsage(usage, "No input for " + std::string(solver->Id) + " at " + (path.empty() ? root / solver->Directory : path).string());
+		}
+	}
+
+	for(auto const& [solver, path] : selected) {
+		auto const fixtures = path.empty() ? findFixtures(*solver, root, fixturePrefixes) : std::vector{ path };
+
+		for(auto const& fixture : fixtures) {
+			std::cerr << solver->Id << ' ' << fixture.filename().string() << '\n';
+
+			measurements.emplace_back(measure(*solver, fixture, runs, warmup));
+		}
+	}
+
+	std::cout << "{\n";
+	std::cout << "\t\"runs\": " << runs << ",\n";
+	std::cout << "\t\"warmup\": " << warmup << ",\n";
+	std::cout << "\t\"threads\": " << aoc::TaskPool::Get().GetThreadCount() << ",\n";
+	std::cout << "\t\"results\": [\n";
+
+	for(std::size_t i = 0; i < measurements.size(); ++i) {
+		printMeasurement(measurements[i], i + 1 == measurements.size());
+	}
+
+	std::cout << "\t]\n";
+	std::cout << "}" << std::endl;
+
+	return 0;
+}
@@ -0,0 +1,174 @@
+#pragma once
+
+// Opt-in heap accounting: with AOC_TRACK_ALLOCATIONS=1 the global operator new/delete are replaced by
+// versions that feed the counters of memory.h. Replacements may only be defined once per program, so only
+// the tool's main.cpp includes this header. Peak RSS comes from the OS and works either way.
+
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+
+#include "memory.h"
+
+#if defined(_WIN32)
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#include <malloc.h>
+#include <psapi.h>
+#pragma comment(lib, "psapi.lib")
+#elif defined(__APPLE__)
+#include <malloc/malloc.h>
+#include <sys/resource.h>
+#else
+#include <malloc.h>
+#include <sys/resource.h>
+#endif
+
+namespace aoc {
+
+	// High-water mark of the whole process, it never goes down.
+	inline long long getPeakRss() noexcept {
+#if defined(_WIN32)
+		PROCESS_MEMORY_COUNTERS counters{};
+
+		if(!GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) {
+			return 0;
+		}
+
+		return (long long)(counters.PeakWorkingSetSize);
+#else
+		rusage usage{};
+
+		if(getrusage(RUSAGE_SELF, &usage) != 0) {
+			return 0;
+		}
+
+#if defined(__APPLE__)
+		return (long long)(usage.ru_maxrss);
+#else
+		return (long long)(usage.ru_maxrss) * 1024;
+#endif
+#endif
+	}
+
+}
+
+#if AOC_TRACK_ALLOCATIONS
+
+namespace aoc::allocations {
+
+	inline std::size_t usableSize(void* pointer) noexcept {
+#if defined(_WIN32)
+		return _msize(pointer);
+#elif defined(__APPLE__)
+		return malloc_size(pointer);
+#else
+		return malloc_usable_size(pointer);
+#endif
+	}
+
+	inline std::size_t usableSize(void* pointer, std::align_val_t alignment) noexcept {
+#if defined(_WIN32)
+		return _aligned_msize(pointer, std::size_t(alignment), 0);
+#else
+		(void)alignment;
+		return usableSize(pointer);
+#endif
+	}
+
+	inline void* allocate(std::size_t size) noexcept {
+		void* const pointer = std::malloc(size ? size : 1);
+
+		if(pointer) {
+			onAllocate(size, usableSize(pointer));
+		}
+
+		return pointer;
+	}
+
+	inline void* allocate(std::size_t size, std::align_val_t alignment) noexcept {
+		auto const align = std::size_t(alignment);
+#if defined(_WIN32)
+		void* const pointer = _aligned_malloc(size ? size : 1, align);
+#else
+		// aligned_alloc wants the size to be a multiple of the alignment
+		void* const pointer = std::aligned_alloc(align, ((size ? size : 1) + align - 1) / align * align);
+#endif
+
+		if(pointer) {
+			onAllocate(size, usableSize(pointer, alignment));
+		}
+
+		return pointer;
+	}
+
+	inline void deallocate(void* pointer) noexcept {
+		if(pointer) {
+			onDeallocate(usableSize(pointer));
+			std::free(pointer);
+		}
+	}
+
+	inline void deallocate(void* pointer, std::align_val_t alignment) noexcept {
+		if(pointer) {
+			onDeallocate(usableSize(pointer, alignment));
+#if defined(_WIN32)
+			_aligned_free(pointer);
+#else
+			std::free(pointer);
+#endif
+		}
+	}
+
+	inline void* allocateOrThrow(std::size_t size) {
+		void* const pointer = allocate(size);
+
+		[[unlikely]]
+		if(!pointer) {
+			throw std::bad_alloc();
+		}
+
+		return pointer;
+	}
+
+	inline void* allocateOrThrow(std::size_t size, std::align_val_t alignment) {
+		void* const pointer = allocate(size, alignment);
+
+		[[unlikely]]
+		if(!pointer) {
+			throw std::bad_alloc();
+		}
+
+		return pointer;
+	}
+
+}
+
+void* operator new(std::size_t size) { return aoc::allocations::allocateOrThrow(size); }
+void* operator new[](std::size_t size) { return aoc::allocations::allocateOrThrow(size); }
+void* operator new(std::size_t size, std::nothrow_t const&) noexcept { return aoc::allocations::allocate(size); }
+void* operator new[](std::size_t size, std::nothrow_t const&) noexcept { return aoc::allocations::allocate(size); }
+void* operator new(std::size_t size, std::align_val_t alignment) { return aoc::allocations::allocateOrThrow(size, alignment); }
+void* operator new[](std::size_t size, std::align_val_t alignment) { return aoc::allocations::allocateOrThrow(size, alignment); }
+void* operator new(std::size_t size, std::align_val_t alignment, std::nothrow_t const&) noexcept { return aoc::allocations::allocate(size, alignment); }
+void* operator new[](std::size_t size, std::align_val_t alignment, std::nothrow_t const&) noexcept { return aoc::allocations::allocate(size, alignment); }
+
+void operator delete(void* pointer) noexcept { aoc::allocations::deallocate(pointer); }
+void operator delete[](void* pointer) noexcept { aoc::allocations::deallocate(pointer); }
+void operator delete(void* pointer, std::size_t) noexcept { aoc::allocations::deallocate(pointer); }
+void operator delete[](void* pointer, std::size_t) noexcept { aoc::allocations::deallocate(pointer); }
+void operator delete(void* pointer, std::nothrow_t const&) noexcept { aoc::allocations::deallocate(pointer); }
+void operator delete[](void* pointer, std::nothrow_t const&) noexcept { aoc::allocations::deallocate(pointer); }
+void operator delete(void* pointer, std::align_val_t alignment) noexcept { aoc::allocations::deallocate(pointer, alignment); }
+void operator delete[](void* pointer, std::align_val_t alignment) noexcept { aoc::allocations::deallocate(pointer, alignment); }
+void operator delete(void* pointer, std::size_t, std::align_val_t alignment) noexcept { aoc::allocations::deallocate(pointer, alignment); }
+void operator delete[](void* pointer, std::size_t, std::align_val_t alignment) noexcept { aoc::allocations::deallocate(pointer, alignment); }
+void operator delete(void* pointer, std::align_val_t alignment, std::nothrow_t const&) noexcept { aoc::allocations::deallocate(pointer, alignment); }
+void operator delete[](void* pointer, std::align_val_t alignment, std::nothrow_t const&) noexcept { aoc::allocations::deallocate(pointer, alignment); }
+
+#endif
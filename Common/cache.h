@@ -0,0 +1,161 @@
+#pragma once
+
+#include "crash.h"
+#include "files.h"
+#include "hash.h"
+#include "solver.h"
+
+#include <algorithm>
+#include <charconv>
+#include <filesystem>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <type_traits>
+#include <variant>
+
+namespace aoc {
+
+	// On-disk answers keyed by the solver, its version and a hash of the input bytes, one small file per
+	// entry. Entries are written to a temporary file and renamed into place, so concurrent writers (batch
+	// workers, parallel processes) never expose a half-written entry and a reader sees either nothing or a
+	// complete one. Anything unreadable is treated as a miss and simply rewritten.
+	class ResultCache {
+	public:
+		explicit ResultCache(std::filesystem::path directory) : Directory(std::move(directory)) {
+			std::error_code error;
+			std::filesystem::create_directories(Directory, error);
+
+			[[unlikely]]
+			if(error) {
+				crash("Could not create the cache directory " + Directory.string() + ": " + error.message());
+			}
+		}
+
+		// Solves on a miss and remembers the answers for next time.
+		Answers Solve(Solver const& solver, std::string_view input) const {
+			auto const path = GetEntryPath(solver, input);
+
+			if(auto cached = Read(path)) {
+				return *std::move(cached);
+			}
+
+			auto answers = solver.Solve(input);
+
+			Write(path, answers);
+
+			return answers;
+		}
+
+		std::optional<Answers> Find(Solver const& solver, std::string_view input) const {
+			return Read(GetEntryPath(solver, input));
+		}
+
+		void Store(Solver const& solver, std::string_view input, Answers const& answers) const {
+			Write(GetEntryPath(solver, input), answers);
+		}
+
+	private:
+		static constexpr std::string_view header = "aoc-answers 1\n";
+
+		// the size in the name makes a colliding hash even less likely to hand out wrong answers
+		std::filesystem::path GetEntryPath(Solver const& solver, std::string_view input) const {
+			return Directory / (std::string(solver.Id) + "-v" + std::to_string(solver.Version) + "-" + toHexString(hashBytes(input)) + "-" + std::to_string(input.size()));
+		}
+
+		static void AppendAnswer(std::string& text, Answer const& answer) {
+			std::visit([&text](auto const& value) {
+				using T = std::decay_t<decltype(value)>;
+
+				if constexpr(std::is_same_v<T, std::monostate>) {
+					text += "-\n";
+				}
+				else if constexpr(std::is_same_v<T, long long>) {
+					text += "i " + std::to_string(value) + "\n";
+				}
+				else {
+					text += "s " + std::to_string(value.size()) + "\n" + value + "\n";
+				}
+			}, answer);
+		}
+
+		// Reads one answer and advances past it, false on anything malformed.
+		static bool ParseAnswer(std::string_view& text, Answer& answer) {
+			auto const lineEnd = text.find('\n');
+
+			if(lineEnd == std::string_view::npos || lineEnd == 0) {
+				return false;
+			}
+
+			auto const kind = text[0];
+			auto const argument = text.substr(std::min<std::size_t>(2, lineEnd), lineEnd - std::min<std::size_t>(2, lineEnd));
+
+			text.remove_prefix(lineEnd + 1);
+
+			if(kind == '-') {
+				answer = std::monostate{};
+				return true;
+			}
+
+			long long value{};
+			auto const [end, error] = std::from_chars(argument.data(), argument.data() + argument.size(), value);
+
+			if(error != std::errc{} || end != argument.data() + argument.size()) {
+				return false;
+			}
+
+			if(kind == 'i') {
+				answer = value;
+				return true;
+			}
+
+			if(kind != 's' || value < 0 || std::size_t(value) + 1 > text.size() || text[std::size_t(value)] != '\n') {
+				return false;
+			}
+
+			answer = std::string(text.substr(0, std::size_t(value)));
+			text.remove_prefix(std::size_t(value) + 1);
+
+			return true;
+		}
+
+		static std::optional<Answers> Read(std::filesystem::path const& path) {
+			std::string content;
+
+			if(!readWholeFile(path, content)) {
+				return std::nullopt;
+			}
+
+			std::string_view text(content);
+
+			if(!text.starts_with(header)) {
+				return std::nullopt;
+			}
+
+			text.remove_prefix(header.size());
+
+			Answers answers;
+
+			if(!ParseAnswer(text, answers.Part1) || !ParseAnswer(text, answers.Part2) || !text.empty()) {
+				return std::nullopt;
+			}
+
+			return answers;
+		}
+
+		static void Write(std::filesystem::path const& path, Answers const& answers) {
+			std::string text(header);
+
+			AppendAnswer(text, answers.Part1);
+			AppendAnswer(text, answers.Part2);
+
+			// a failed store only costs a recomputation next time, and if another writer got there first its
+			// entry is just as good
+			writeFileAtomically(path, text);
+		}
+
+		std::filesystem::path Directory;
+	};
+
+}
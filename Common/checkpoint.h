@@ -0,0 +1,177 @@
+#pragma once
+
+#include "crash.h"
+#include "files.h"
+#include "hash.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <mutex>
+#include <span>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace aoc {
+
+	namespace checkpoints {
+
+		// Empty falls back to AOC_CHECKPOINT_DIR; without either, checkpoints are off.
+		inline std::string requestedDirectory;
+
+		inline std::filesystem::path resolveDirectory() {
+			if(!requestedDirectory.empty()) {
+				return requestedDirectory;
+			}
+
+			if(char const* const fromEnvironment = std::getenv("AOC_CHECKPOINT_DIR"); fromEnvironment && *fromEnvironment) {
+				return fromEnvironment;
+			}
+
+			return {};
+		}
+
+		inline constexpr char magic[8] = { 'a', 'o', 'c', 'c', 'k', 'p', 't', '1' };
+
+	}
+
+	// Has to be called before a solver runs, e.g. while parsing the command line.
+	inline void setCheckpointDirectory(std::string directory) {
+		checkpoints::requestedDirectory = std::move(directory);
+	}
+
+	// Progress of one long solve of one input, kept as named records of plain values. Every record is
+	// written atomically and carries a checksum, so after a crash or preemption a rerun of the same solver
+	// on the same input finds each record either complete or not at all, and resumes from there. Records
+	// are keyed like the result cache by the solver version, which has to be bumped whenever the layout of
+	// a record changes, and by the width of its values. Without a checkpoint directory nothing is stored.
+	class Checkpoint {
+	public:
+		Checkpoint(std::string_view solverId, int version, std::string_view input) : Directory(checkpoints::resolveDirectory()) {
+			if(Directory.empty()) {
+				return;
+			}
+
+			std::error_code error;
+			std::filesystem::create_directories(Directory, error);
+
+			[[unlikely]]
+			if(error) {
+				crash("Could not create the checkpoint directory " + Directory.string() + ": " + error.message());
+			}
+
+			Prefix = std::string(solverId) + "-v" + std::to_string(version) + "-" + toHexString(hashBytes(input)) + "-" + std::to_string(input.size()) + "-";
+		}
+
+		bool IsEnabled() const noexcept {
+			return !Directory.empty();
+		}
+
+		// Fills values from the record, false (leaving values alone) when there is no complete record of
+		// exactly that size.
+		template<typename T>
+		bool Load(std::string_view record, std::span<T> values) const {
+			static_assert(std::is_trivially_copyable_v<T>);
+
+			if(!IsEnabled()) {
+				return false;
+			}
+
+			auto const path = GetPath(record, sizeof(T));
+
+			std::string content;
+
+			if(!readWholeFile(path, content)) {
+				return false;
+			}
+
+			auto const payloadSize = values.size_bytes();
+
+			if(content.size() != sizeof(checkpoints::magic) + payloadSize + sizeof(std::uint64_t) || std::memcmp(content.data(), checkpoints::magic, sizeof(checkpoints::magic)) != 0) {
+				return false;
+			}
+
+			std::string_view const payload(content.data() + sizeof(checkpoints::magic), payloadSize);
+
+			std::uint64_t checksum;
+			std::memcpy(&checksum, payload.data() + payload.size(), sizeof(checksum));
+
+			if(checksum != hashBytes(payload)) {
+				return false;
+			}
+
+			std::memcpy(values.data(), payload.data(), payloadSize);
+
+			Own(path);
+
+			return true;
+		}
+
+		// Safe to call from several tasks at once.
+		template<typename T>
+		void Save(std::string_view record, std::span<T const> values) const {
+			static_assert(std::is_trivially_copyable_v<T>);
+
+			if(!IsEnabled()) {
+				return;
+			}
+
+			std::string_view const payload(reinterpret_cast<char const*>(values.data()), values.size_bytes());
+			auto const checksum = hashBytes(payload);
+
+			std::string content;
+			content.reserve(sizeof(checkpoints::magic) + payload.size() + sizeof(checksum));
+			content.append(checkpoints::magic, sizeof(checkpoints::magic));
+			content.append(payload);
+			content.append(reinterpret_cast<char const*>(&checksum), sizeof(checksum));
+
+			auto const path = GetPath(record, sizeof(T));
+
+			// a lost checkpoint only costs recomputing that part after a crash
+			if(writeFileAtomically(path, content)) {
+				Own(path);
+			}
+		}
+
+		// Removes the records this solve saved or resumed from. Temporary files and records of anything else
+		// are left alone; a concurrent solve of the same input that still needs a removed record only has to
+		// recompute that part.
+		void Discard() const {
+			std::scoped_lock lock(OwnedMutex);
+
+			std::error_code error;
+
+			for(auto const& path : Owned) {
+				std::filesystem::remove(path, error);
+			}
+
+			Owned.clear();
+		}
+
+	private:
+		std::filesystem::path GetPath(std::string_view record, std::size_t valueSize) const {
+			return Directory / (Prefix + std::string(record) + "-w" + std::to_string(valueSize));
+		}
+
+		void Own(std::filesystem::path const& path) const {
+			std::scoped_lock lock(OwnedMutex);
+
+			if(std::find(Owned.begin(), Owned.end(), path) == Owned.end()) {
+				Owned.emplace_back(path);
+			}
+		}
+
+		std::filesystem::path Directory;
+		std::string Prefix;
+
+		mutable std::mutex OwnedMutex;
+		mutable std::vector<std::filesystem::path> Owned;
+	};
+
+}
@@ -0,0 +1,32 @@
+#pragma once
+
+// Command line helpers shared by the tools (driver, benchmark, batch, generator, embed).
+
+#include <charconv>
+#include <iostream>
+#include <optional>
+#include <string_view>
+#include <system_error>
+
+namespace aoc {
+
+	// The value of a --threads option: a positive number and nothing else, or nullopt.
+	inline std::optional<int> parseThreadCount(std::string_view text) {
+		int count{};
+		auto const [end, error] = std::from_chars(text.data(), text.data() + text.size(), count);
+
+		if(error != std::errc{} || end != text.data() + text.size() || count < 1) {
+			return std::nullopt;
+		}
+
+		return count;
+	}
+
+	// The command line tools report a mistake with the message and their usage and return this from main,
+	// so it ends with exit code 1 instead of a crash.
+	inline int failUsage(std::string_view usage, std::string_view message) {
+		std::cerr << message << '\n' << usage << '\n';
+		return 1;
+	}
+
+}
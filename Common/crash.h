@@ -0,0 +1,40 @@
+#pragma once
+
+#include <atomic>
+#include <exception>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+namespace aoc {
+
+	// What crash throws once failures are recoverable.
+	class Failure : public std::runtime_error {
+	public:
+		using std::runtime_error::runtime_error;
+	};
+
+	namespace failures {
+
+		inline std::atomic<bool> areRecoverable{ false };
+
+	}
+
+	// For tools that run many solves: from then on crash throws aoc::Failure instead of ending the program,
+	// so a malformed input only fails its own solve. Has to be called before any solver runs.
+	inline void makeFailuresRecoverable() noexcept {
+		failures::areRecoverable = true;
+	}
+
+	[[noreturn]]
+	inline void crash(std::string_view message) {
+		if(failures::areRecoverable) {
+			throw Failure(std::string(message));
+		}
+
+		std::cerr << message << std::endl;
+		std::terminate();
+	}
+
+}
@@ -0,0 +1,62 @@
+#pragma once
+
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <iterator>
+#include <random>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <thread>
+
+namespace aoc {
+
+	// The whole file, false when it cannot be read.
+	inline bool readWholeFile(std::filesystem::path const& path, std::string& content) {
+		std::ifstream file(path, std::ios::binary);
+
+		if(!file) {
+			return false;
+		}
+
+		content.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+
+		return !file.bad();
+	}
+
+	// Writes a uniquely named temporary file next to path and renames it into place, so readers see either
+	// the previous content or the complete new one, and two writers never share a temporary file. False
+	// when nothing was written.
+	inline bool writeFileAtomically(std::filesystem::path const& path, std::string_view content) {
+		thread_local std::mt19937_64 random(std::random_device{}() ^ std::hash<std::thread::id>{}(std::this_thread::get_id()));
+
+		auto temporaryPath = path;
+		temporaryPath += ".tmp" + std::to_string(random());
+
+		{
+			std::ofstream file(temporaryPath, std::ios::binary | std::ios::trunc);
+
+			file.write(content.data(), std::streamsize(content.size()));
+
+			if(!file) {
+				file.close();
+				std::error_code ignored;
+				std::filesystem::remove(temporaryPath, ignored);
+				return false;
+			}
+		}
+
+		std::error_code error;
+		std::filesystem::rename(temporaryPath, path, error);
+
+		// on Windows the rename fails while the target is open elsewhere; the old content stays
+		if(error) {
+			std::filesystem::remove(temporaryPath, error);
+			return false;
+		}
+
+		return true;
+	}
+
+}
@@ -0,0 +1,361 @@
+#pragma once
+
+#include <algorithm>
+#include <compare>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <span>
+#include <type_traits>
+#include <vector>
+
+namespace aoc {
+
+	namespace grid {
+
+		// Where the cells of a padded grid live in one flat buffer. Coordinates run from -padding to
+		// size + padding - 1 on every axis, so a neighbour lookup next to the edge lands in the border
+		// instead of needing a bounds check; the border holds whatever sentinel the owner fills it with.
+		struct Layout2D {
+			Layout2D() = default;
+
+			Layout2D(int width, int height, int padding) noexcept :
+				Width(width), Height(height), Padding(padding),
+				Stride(std::ptrdiff_t(width) + 2 * padding),
+				Origin(std::ptrdiff_t(padding) * Stride + padding)
+			{}
+
+			std::size_t GetCellCount() const noexcept {
+				return std::size_t(Stride * (std::ptrdiff_t(Height) + 2 * Padding));
+			}
+
+			std::ptrdiff_t IndexOf(int x, int y) const noexcept {
+				return Origin + std::ptrdiff_t(y) * Stride + x;
+			}
+
+			bool Contains(int x, int y) const noexcept {
+				return x >= 0 && y >= 0 && x < Width && y < Height;
+			}
+
+			int Width{}, Height{}, Padding{};
+			std::ptrdiff_t Stride{};
+			std::ptrdiff_t Origin{};
+		};
+
+		struct Layout3D {
+			Layout3D() = default;
+
+			Layout3D(int sizeX, int sizeY, int sizeZ, int padding) noexcept :
+				SizeX(sizeX), SizeY(sizeY), SizeZ(sizeZ), Padding(padding),
+				StrideY(std::ptrdiff_t(sizeX) + 2 * padding),
+				StrideZ(StrideY * (std::ptrdiff_t(sizeY) + 2 * padding)),
+				Origin(std::ptrdiff_t(padding) * (StrideZ + StrideY + 1))
+			{}
+
+			std::size_t GetCellCount() const noexcept {
+				return std::size_t(StrideZ * (std::ptrdiff_t(SizeZ) + 2 * Padding));
+			}
+
+			std::ptrdiff_t IndexOf(int x, int y, int z) const noexcept {
+				return Origin + std::ptrdiff_t(z) * StrideZ + std::ptrdiff_t(y) * StrideY + x;
+			}
+
+			bool Contains(int x, int y, int z) const noexcept {
+				return x >= 0 && y >= 0 && z >= 0 && x < SizeX && y < SizeY && z < SizeZ;
+			}
+
+			int SizeX{}, SizeY{}, SizeZ{}, Padding{};
+			std::ptrdiff_t StrideY{};
+			std::ptrdiff_t StrideZ{};
+			std::ptrdiff_t Origin{};
+		};
+
+		// Every stride-th element starting at data, e.g. one column of a grid.
+		template<typename T>
+		class StridedSpan {
+		public:
+			class Iterator {
+			public:
+				using iterator_category = std::random_access_iterator_tag;
+				using value_type = std::remove_cv_t<T>;
+				using difference_type = std::ptrdiff_t;
+				using pointer = T*;
+				using reference = T&;
+
+				Iterator() = default;
+
+				Iterator(T* element, std::ptrdiff_t stride) noexcept : Element(element), Stride(stride) {}
+
+				T& operator*() const noexcept { return *Element; }
+				T& operator[](std::ptrdiff_t offset) const noexcept { return Element[offset * Stride]; }
+
+				Iterator& operator++() noexcept { Element += Stride; return *this; }
+				Iterator operator++(int) noexcept { auto previous = *this; Element += Stride; return previous; }
+				Iterator& operator--() noexcept { Element -= Stride; return *this; }
+				Iterator operator--(int) noexcept { auto previous = *this; Element -= Stride; return previous; }
+				Iterator& operator+=(std::ptrdiff_t offset) noexcept { Element += offset * Stride; return *this; }
+				Iterator& operator-=(std::ptrdiff_t offset) noexcept { Element -= offset * Stride; return *this; }
+
+				friend Iterator operator+(Iterator it, std::ptrdiff_t offset) noexcept { return it += offset; }
+				friend Iterator operator+(std::ptrdiff_t offset, Iterator it) noexcept { return it += offset; }
+				friend Iterator operator-(Iterator it, std::ptrdiff_t offset) noexcept { return it -= offset; }
+				friend std::ptrdiff_t operator-(Iterator const& a, Iterator const& b) noexcept { return (a.Element - b.Element) / a.Stride; }
+
+				friend bool operator==(Iterator const& a, Iterator const& b) noexcept { return a.Element == b.Element; }
+				friend auto operator<=>(Iterator const& a, Iterator const& b) noexcept { return a.Element <=> b.Element; }
+
+			private:
+				T* Element{ nullptr };
+				std::ptrdiff_t Stride{ 1 };
+			};
+
+			StridedSpan(T* data, std::size_t size, std::ptrdiff_t stride) noexcept : Data(data), Size(size), Stride(stride) {}
+
+			std::size_t size() const noexcept { return Size; }
+			T& operator[](std::size_t index) const noexcept { return Data[std::ptrdiff_t(index) * Stride]; }
+
+			Iterator begin() const noexcept { return Iterator(Data, Stride); }
+			Iterator end() const noexcept { return Iterator(Data + std::ptrdiff_t(Size) * Stride, Stride); }
+
+		private:
+			T* Data;
+			std::size_t Size;
+			std::ptrdiff_t Stride;
+		};
+
+		// One bit per cell, for the packed bool grids.
+		class Bits {
+		public:
+			class Reference {
+			public:
+				Reference(std::uint64_t& word, std::uint64_t mask) noexcept : Word(word), Mask(mask) {}
+
+				operator bool() const noexcept {
+					return (Word & Mask) != 0;
+				}
+
+				Reference& operator=(bool value) noexcept {
+					Word = value ? Word | Mask : Word & ~Mask;
+					return *this;
+				}
+
+				Reference& operator=(Reference const& other) noexcept {
+					return *this = bool(other);
+				}
+
+			private:
+				std::uint64_t& Word;
+				std::uint64_t Mask;
+			};
+
+			Bits() = default;
+
+			explicit Bits(std::size_t count, bool value = false) : Words((count + 63) / 64, value ? ~std::uint64_t{} : 0) {}
+
+			bool Test(std::size_t index) const noexcept {
+				return (Words[index >> 6] >> (index & 63)) & 1;
+			}
+
+			Reference operator[](std::size_t index) noexcept {
+				return Reference(Words[index >> 6], std::uint64_t(1) << (index & 63));
+			}
+
+		private:
+			std::vector<std::uint64_t> Words;
+		};
+
+	}
+
+	// Contiguous width x height grid, addressed as grid(x, y). With padding the grid is surrounded by that
+	// many cells on each side, filled with border, which are just as addressable as the inside ones.
+	template<typename T>
+	class Grid2D {
+	public:
+		Grid2D() = default;
+
+		Grid2D(int width, int height, T const& value = T{}, int padding = 0, T const& border = T{}) :
+			Layout(width, height, padding), Cells(Layout.GetCellCount(), border)
+		{
+			Fill(value);
+		}
+
+		int GetWidth() const noexcept { return Layout.Width; }
+		int GetHeight() const noexcept { return Layout.Height; }
+		int GetPadding() const noexcept { return Layout.Padding; }
+
+		bool Contains(int x, int y) const noexcept {
+			return Layout.Contains(x, y);
+		}
+
+		T& operator()(int x, int y) noexcept {
+			return Cells[std::size_t(Layout.IndexOf(x, y))];
+		}
+
+		T const& operator()(int x, int y) const noexcept {
+			return Cells[std::size_t(Layout.IndexOf(x, y))];
+		}
+
+		// The inside of row y, without its padding.
+		std::span<T> Row(int y) noexcept {
+			return std::span<T>(&(*this)(0, y), std::size_t(Layout.Width));
+		}
+
+		std::span<T const> Row(int y) const noexcept {
+			return std::span<T const>(&(*this)(0, y), std::size_t(Layout.Width));
+		}
+
+		grid::StridedSpan<T> Column(int x) noexcept {
+			return grid::StridedSpan<T>(&(*this)(x, 0), std::size_t(Layout.Height), Layout.Stride);
+		}
+
+		grid::StridedSpan<T const> Column(int x) const noexcept {
+			return grid::StridedSpan<T const>(&(*this)(x, 0), std::size_t(Layout.Height), Layout.Stride);
+		}
+
+		// Sets the inside only, the border keeps its sentinel.
+		void Fill(T const& value) {
+			for(int y = 0; y < Layout.Height; ++y) {
+				std::ranges::fill(Row(y), value);
+			}
+		}
+
+	private:
+		grid::Layout2D Layout;
+		std::vector<T> Cells;
+	};
+
+	// Packed one bit per cell; cells are read with grid(x, y) and written through the returned reference.
+	template<>
+	class Grid2D<bool> {
+	public:
+		Grid2D() = default;
+
+		Grid2D(int width, int height, bool value = false, int padding = 0, bool border = false) :
+			Layout(width, height, padding), Cells(Layout.GetCellCount(), border)
+		{
+			Fill(value);
+		}
+
+		int GetWidth() const noexcept { return Layout.Width; }
+		int GetHeight() const noexcept { return Layout.Height; }
+		int GetPadding() const noexcept { return Layout.Padding; }
+
+		bool Contains(int x, int y) const noexcept {
+			return Layout.Contains(x, y);
+		}
+
+		grid::Bits::Reference operator()(int x, int y) noexcept {
+			return Cells[std::size_t(Layout.IndexOf(x, y))];
+		}
+
+		bool operator()(int x, int y) const noexcept {
+			return Cells.Test(std::size_t(Layout.IndexOf(x, y)));
+		}
+
+		void Fill(bool value) noexcept {
+			for(int y = 0; y < Layout.Height; ++y) {
+				for(int x = 0; x < Layout.Width; ++x) {
+					(*this)(x, y) = value;
+				}
+			}
+		}
+
+	private:
+		grid::Layout2D Layout;
+		grid::Bits Cells;
+	};
+
+	// Contiguous sizeX x sizeY x sizeZ grid with x running fastest, padded like Grid2D.
+	template<typename T>
+	class Grid3D {
+	public:
+		Grid3D() = default;
+
+		Grid3D(int sizeX, int sizeY, int sizeZ, T const& value = T{}, int padding = 0, T const& border = T{}) :
+			Layout(sizeX, sizeY, sizeZ, padding), Cells(Layout.GetCellCount(), border)
+		{
+			Fill(value);
+		}
+
+		int GetSizeX() const noexcept { return Layout.SizeX; }
+		int GetSizeY() const noexcept { return Layout.SizeY; }
+		int GetSizeZ() const noexcept { return Layout.SizeZ; }
+		int GetPadding() const noexcept { return Layout.Padding; }
+
+		bool Contains(int x, int y, int z) const noexcept {
+			return Layout.Contains(x, y, z);
+		}
+
+		T& operator()(int x, int y, int z) noexcept {
+			return Cells[std::size_t(Layout.IndexOf(x, y, z))];
+		}
+
+		T const& operator()(int x, int y, int z) const noexcept {
+			return Cells[std::size_t(Layout.IndexOf(x, y, z))];
+		}
+
+		std::span<T> Row(int y, int z) noexcept {
+			return std::span<T>(&(*this)(0, y, z), std::size_t(Layout.SizeX));
+		}
+
+		std::span<T const> Row(int y, int z) const noexcept {
+			return std::span<T const>(&(*this)(0, y, z), std::size_t(Layout.SizeX));
+		}
+
+		void Fill(T const& value) {
+			for(int z = 0; z < Layout.SizeZ; ++z) {
+				for(int y = 0; y < Layout.SizeY; ++y) {
+					std::ranges::fill(Row(y, z), value);
+				}
+			}
+		}
+
+	private:
+		grid::Layout3D Layout;
+		std::vector<T> Cells;
+	};
+
+	template<>
+	class Grid3D<bool> {
+	public:
+		Grid3D() = default;
+
+		Grid3D(int sizeX, int sizeY, int sizeZ, bool value = false, int padding = 0, bool border = false) :
+			Layout(sizeX, sizeY, sizeZ, padding), Cells(Layout.GetCellCount(), border)
+		{
+			Fill(value);
+		}
+
+		int GetSizeX() const noexcept { return Layout.SizeX; }
+		int GetSizeY() const noexcept { return Layout.SizeY; }
+		int GetSizeZ() const noexcept { return Layout.SizeZ; }
+		int GetPadding() const noexcept { return Layout.Padding; }
+
+		bool Contains(int x, int y, int z) const noexcept {
+			return Layout.Contains(x, y, z);
+		}
+
+		grid::Bits::Reference operator()(int x, int y, int z) noexcept {
+			return Cells[std::size_t(Layout.IndexOf(x, y, z))];
+		}
+
+		bool operator()(int x, int y, int z) const noexcept {
+			return Cells.Test(std::size_t(Layout.IndexOf(x, y, z)));
+		}
+
+		void Fill(bool value) noexcept {
+			for(int z = 0; z < Layout.SizeZ; ++z) {
+				for(int y = 0; y < Layout.SizeY; ++y) {
+					for(int x = 0; x < Layout.SizeX; ++x) {
+						(*this)(x, y, z) = value;
+					}
+				}
+			}
+		}
+
+	private:
+		grid::Layout3D Layout;
+		grid::Bits Cells;
+	};
+
+}
@@ -0,0 +1,150 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#endif
+
+// wyhash-style hashing: 64x64 -> 128 bit multiplies folded back to 64 bits, reading 48 bytes per round
+// on long inputs. Fast and well mixed, not meant to resist deliberate collisions.
+namespace aoc {
+
+	namespace hashing {
+
+		inline constexpr std::uint64_t secret[4] = { 0xa0761d6478bd642full, 0xe7037ed1a0b428dbull, 0x8ebc6af09c88c6e3ull, 0x589965cc75374cc3ull };
+
+		// a * b as 128 bits, the low half written to a and the high half to b
+		inline void multiply(std::uint64_t& a, std::uint64_t& b) noexcept {
+#if defined(__SIZEOF_INT128__)
+			auto const product = static_cast<unsigned __int128>(a) * b;
+			a = std::uint64_t(product);
+			b = std::uint64_t(product >> 64);
+#elif defined(_MSC_VER) && defined(_M_X64)
+			a = _umul128(a, b, &b);
+#else
+			auto const aHigh = a >> 32, aLow = a & 0xffffffffull;
+			auto const bHigh = b >> 32, bLow = b & 0xffffffffull;
+			auto const high = aHigh * bHigh, middle1 = aHigh * bLow, middle2 = aLow * bHigh, low = aLow * bLow;
+			auto const carry = ((low >> 32) + (middle1 & 0xffffffffull) + (middle2 & 0xffffffffull)) >> 32;
+			a = low + (middle1 << 32) + (middle2 << 32);
+			b = high + (middle1 >> 32) + (middle2 >> 32) + carry;
+#endif
+		}
+
+		inline std::uint64_t mix(std::uint64_t a, std::uint64_t b) noexcept {
+			multiply(a, b);
+			return a ^ b;
+		}
+
+		inline std::uint64_t read64(unsigned char const* p) noexcept {
+			std::uint64_t value;
+			std::memcpy(&value, p, sizeof(value));
+			return value;
+		}
+
+		inline std::uint64_t read32(unsigned char const* p) noexcept {
+			std::uint32_t value;
+			std::memcpy(&value, p, sizeof(value));
+			return value;
+		}
+
+		// 1 to 3 bytes
+		inline std::uint64_t readSmall(unsigned char const* p, std::size_t size) noexcept {
+			return (std::uint64_t(p[0]) << 16) | (std::uint64_t(p[size >> 1]) << 8) | p[size - 1];
+		}
+
+	}
+
+	inline std::uint64_t hashBytes(std::string_view bytes, std::uint64_t seed = 0) noexcept {
+		using namespace hashing;
+
+		auto const* p = reinterpret_cast<unsigned char const*>(bytes.data());
+		auto const size = bytes.size();
+
+		seed ^= mix(seed ^ secret[0], secret[1]);
+
+		std::uint64_t a{};
+		std::uint64_t b{};
+
+		if(size <= 16) {
+			if(size >= 4) {
+				auto const offset = (size >> 3) << 2;
+
+				a = (read32(p) << 32) | read32(p + offset);
+				b = (read32(p + size - 4) << 32) | read32(p + size - 4 - offset);
+			}
+			else if(size > 0) {
+				a = readSmall(p, size);
+			}
+		}
+		else {
+			auto remaining = size;
+
+			if(remaining > 48) {
+				auto seed1 = seed;
+				auto seed2 = seed;
+
+				do {
+					seed = mix(read64(p) ^ secret[1], read64(p + 8) ^ seed);
+					seed1 = mix(read64(p + 16) ^ secret[2], read64(p + 24) ^ seed1);
+					seed2 = mix(read64(p + 32) ^ secret[3], read64(p + 40) ^ seed2);
+					p += 48;
+					remaining -= 48;
+				} while(remaining > 48);
+
+				seed ^= seed1 ^ seed2;
+			}
+
+			while(remaining > 16) {
+				seed = mix(read64(p) ^ secret[1], read64(p + 8) ^ seed);
+				p += 16;
+				remaining -= 16;
+			}
+
+			a = read64(p + remaining - 16);
+			b = read64(p + remaining - 8);
+		}
+
+		a ^= secret[1];
+		b ^= seed;
+		multiply(a, b);
+
+		return mix(a ^ secret[0] ^ size, b ^ secret[1]);
+	}
+
+	// Always 16 digits, for hashes that end up in file names.
+	inline std::string toHexString(std::uint64_t hash) {
+		constexpr char digits[] = "0123456789abcdef";
+
+		std::string hex(16, '0');
+
+		for(int i = 15; i >= 0; --i, hash >>= 4) {
+			hex[std::size_t(i)] = digits[hash & 15];
+		}
+
+		return hex;
+	}
+
+	// Hashes the object bytes of plain keys (coordinates, search states, ...). Keys with padding would hash
+	// equal values differently, so those and keys that own memory need a hasher of their own.
+	template<typename T>
+	struct Hash {
+		static_assert(std::has_unique_object_representations_v<T>, "the key has padding or is not trivially copyable, give it its own hasher");
+
+		std::uint64_t operator()(T const& value) const noexcept {
+			if constexpr(std::is_integral_v<T> || std::is_enum_v<T>) {
+				return hashing::mix(std::uint64_t(value) ^ hashing::secret[0], hashing::secret[1]);
+			}
+			else {
+				return hashBytes(std::string_view(reinterpret_cast<char const*>(&value), sizeof(T)));
+			}
+		}
+	};
+
+}
@@ -0,0 +1,239 @@
+#pragma once
+
+#include "hash.h"
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace aoc {
+
+	namespace hashing {
+
+		struct NoValue {};
+
+		// Open addressing with linear probing over one flat array of slots. Every slot has a control byte next
+		// to it in a separate array: 0 for empty, otherwise the top 7 bits of the key's hash with the high bit
+		// set, so most mismatches on a probe chain are rejected without touching the key. The table only ever
+		// grows; none of the solvers remove states.
+		template<typename Key, typename Value, typename Hasher>
+		class FlatTable {
+		public:
+			struct Slot {
+				Key First;
+				[[no_unique_address]] Value Second;
+			};
+
+			FlatTable() = default;
+
+			explicit FlatTable(std::size_t expectedSize) {
+				Reserve(expectedSize);
+			}
+
+			std::size_t GetSize() const noexcept {
+				return Size;
+			}
+
+			bool IsEmpty() const noexcept {
+				return Size == 0;
+			}
+
+			void Clear() noexcept {
+				std::fill(Controls.begin(), Controls.end(), std::uint8_t{ 0 });
+				Size = 0;
+			}
+
+			void Reserve(std::size_t expectedSize) {
+				auto const capacity = getCapacityFor(expectedSize);
+
+				if(capacity > Slots.size()) {
+					Rehash(capacity);
+				}
+			}
+
+			Slot* Find(Key const& key) noexcept {
+				return const_cast<Slot*>(std::as_const(*this).Find(key));
+			}
+
+			Slot const* Find(Key const& key) const noexcept {
+				if(Size == 0) {
+					return nullptr;
+				}
+
+				auto const hash = Hasher{}(key);
+				auto const control = getControl(hash);
+
+				for(auto index = std::size_t(hash) & Mask; Controls[index] != 0; index = (index + 1) & Mask) {
+					if(Controls[index] == control && Slots[index].First == key) {
+						return &Slots[index];
+					}
+				}
+
+				return nullptr;
+			}
+
+			// The slot of key, default-constructing its value when it is new; the flag tells which happened.
+			std::pair<Slot*, bool> FindOrInsert(Key const& key) {
+				if((Size + 1) * maxLoadDenominator > Slots.size() * maxLoadNumerator) {
+					Rehash(std::max<std::size_t>(minimumCapacity, Slots.size() * 2));
+				}
+
+				auto const hash = Hasher{}(key);
+				auto const control = getControl(hash);
+
+				auto index = std::size_t(hash) & Mask;
+
+				for(; Controls[index] != 0; index = (index + 1) & Mask) {
+					if(Controls[index] == control && Slots[index].First == key) {
+						return { &Slots[index], false };
+					}
+				}
+
+				Controls[index] = control;
+				Slots[index] = Slot{ key, Value{} };
+				++Size;
+
+				return { &Slots[index], true };
+			}
+
+			template<typename Function>
+			void ForEach(Function&& function) const {
+				for(std::size_t index = 0; index < Slots.size(); ++index) {
+					if(Controls[index] != 0) {
+						function(Slots[index]);
+					}
+				}
+			}
+
+		private:
+			// chains stay short up to three quarters full with a well mixed hash
+			static constexpr std::size_t maxLoadNumerator = 3;
+			static constexpr std::size_t maxLoadDenominator = 4;
+			static constexpr std::size_t minimumCapacity = 16;
+
+			static std::size_t getCapacityFor(std::size_t size) noexcept {
+				return std::bit_ceil(std::max(minimumCapacity, (size * maxLoadDenominator + maxLoadNumerator - 1) / maxLoadNumerator));
+			}
+
+			static std::uint8_t getControl(std::uint64_t hash) noexcept {
+				return std::uint8_t(0x80 | (hash >> 57));
+			}
+
+			void Rehash(std::size_t capacity) {
+				auto oldSlots = std::move(Slots);
+				auto oldControls = std::move(Controls);
+
+				Slots = std::vector<Slot>(capacity);
+				Controls = std::vector<std::uint8_t>(capacity, 0);
+				Mask = capacity - 1;
+
+				for(std::size_t oldIndex = 0; oldIndex < oldSlots.size(); ++oldIndex) {
+					if(oldControls[oldIndex] == 0) {
+						continue;
+					}
+
+					auto index = std::size_t(Hasher{}(oldSlots[oldIndex].First)) & Mask;
+
+					while(Controls[index] != 0) {
+						index = (index + 1) & Mask;
+					}
+
+					Controls[index] = oldControls[oldIndex];
+					Slots[index] = std::move(oldSlots[oldIndex]);
+				}
+			}
+
+			std::vector<Slot> Slots;
+			std::vector<std::uint8_t> Controls;
+			std::size_t Mask{ 0 };
+			std::size_t Size{ 0 };
+		};
+
+	}
+
+	// Flat hash map for small trivially copyable keys; references into it are invalidated when it grows.
+	template<typename Key, typename Value, typename Hasher = Hash<Key>>
+	class FlatMap {
+	public:
+		FlatMap() = default;
+
+		explicit FlatMap(std::size_t expectedSize) : Table(expectedSize) {}
+
+		std::size_t GetSize() const noexcept { return Table.GetSize(); }
+		bool IsEmpty() const noexcept { return Table.IsEmpty(); }
+		void Clear() noexcept { Table.Clear(); }
+		void Reserve(std::size_t expectedSize) { Table.Reserve(expectedSize); }
+
+		Value& operator[](Key const& key) {
+			return Table.FindOrInsert(key).first->Second;
+		}
+
+		Value* Find(Key const& key) noexcept {
+			auto* const slot = Table.Find(key);
+			return slot ? &slot->Second : nullptr;
+		}
+
+		Value const* Find(Key const& key) const noexcept {
+			auto const* const slot = Table.Find(key);
+			return slot ? &slot->Second : nullptr;
+		}
+
+		bool Contains(Key const& key) const noexcept {
+			return Table.Find(key) != nullptr;
+		}
+
+		// Inserts value unless key is already there; either way returns the stored value and whether it is new.
+		std::pair<Value*, bool> Insert(Key const& key, Value const& value) {
+			auto const [slot, isInserted] = Table.FindOrInsert(key);
+
+			if(isInserted) {
+				slot->Second = value;
+			}
+
+			return { &slot->Second, isInserted };
+		}
+
+		// function(key, value) for every entry, in no particular order.
+		template<typename Function>
+		void ForEach(Function&& function) const {
+			Table.ForEach([&function](auto const& slot) { function(slot.First, slot.Second); });
+		}
+
+	private:
+		hashing::FlatTable<Key, Value, Hasher> Table;
+	};
+
+	template<typename Key, typename Hasher = Hash<Key>>
+	class FlatSet {
+	public:
+		FlatSet() = default;
+
+		explicit FlatSet(std::size_t expectedSize) : Table(expectedSize) {}
+
+		std::size_t GetSize() const noexcept { return Table.GetSize(); }
+		bool IsEmpty() const noexcept { return Table.IsEmpty(); }
+		void Clear() noexcept { Table.Clear(); }
+		void Reserve(std::size_t expectedSize) { Table.Reserve(expectedSize); }
+
+		// True when key was not in the set yet.
+		bool Insert(Key const& key) {
+			return Table.FindOrInsert(key).second;
+		}
+
+		bool Contains(Key const& key) const noexcept {
+			return Table.Find(key) != nullptr;
+		}
+
+		template<typename Function>
+		void ForEach(Function&& function) const {
+			Table.ForEach([&function](auto const& slot) { function(slot.First); });
+		}
+
+	private:
+		hashing::FlatTable<Key, hashing::NoValue, Hasher> Table;
+	};
+
+}
@@ -0,0 +1,246 @@
+#pragma once
+
+#include "crash.h"
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#if defined(_WIN32)
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace aoc {
+
+	// Splits the buffer the same way std::getline would: no trailing empty line after the final '\n'
+	// and a '\r' before each '\n' is dropped, so CRLF fixtures behave like they do on Windows.
+	inline void splitLines(std::string_view data, std::vector<std::string_view>& lines) {
+		lines.clear();
+
+		std::size_t lineStart = 0;
+
+		while(lineStart < data.size()) {
+			auto lineEnd = data.find('\n', lineStart);
+
+			if(lineEnd == std::string_view::npos) {
+				lineEnd = data.size();
+			}
+
+			auto line = data.substr(lineStart, lineEnd - lineStart);
+
+			if(!line.empty() && line.back() == '\r') {
+				line.remove_suffix(1);
+			}
+
+			lines.emplace_back(line);
+
+			lineStart = lineEnd + 1;
+		}
+	}
+
+	inline std::vector<std::string_view> splitLines(std::string_view data) {
+		std::vector<std::string_view> lines;
+		splitLines(data, lines);
+		return lines;
+	}
+
+	// Read-only memory mapping of a whole input file. Every view handed out points into the mapping,
+	// so the MappedFile has to outlive whatever was parsed from it without copying.
+	class MappedFile {
+	public:
+		explicit MappedFile(std::string const& fileName) {
+#if defined(_WIN32)
+			FileHandle = CreateFileA(fileName.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+
+			[[unlikely]]
+			if(FileHandle == INVALID_HANDLE_VALUE) {
+				crash("Could not open the input file " + fileName);
+			}
+
+			LARGE_INTEGER fileSize{};
+
+			[[unlikely]]
+			if(!GetFileSizeEx(FileHandle, &fileSize)) {
+				crash("Could not get the size of " + fileName);
+			}
+
+			Size = std::size_t(fileSize.QuadPart);
+
+			if(Size == 0) {
+				return;
+			}
+
+			MappingHandle = CreateFileMappingA(FileHandle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+
+			[[unlikely]]
+			if(MappingHandle == nullptr) {
+				crash("Could not map " + fileName);
+			}
+
+			Buffer = static_cast<char const*>(MapViewOfFile(MappingHandle, FILE_MAP_READ, 0, 0, 0));
+#else
+			Descriptor = open(fileName.c_str(), O_RDONLY);
+
+			[[unlikely]]
+			if(Descriptor < 0) {
+				crash("Could not open the input file " + fileName);
+			}
+
+			struct stat fileStat{};
+
+			[[unlikely]]
+			if(fstat(Descriptor, &fileStat) != 0) {
+				crash("Could not get the size of " + fileName);
+			}
+
+			Size = std::size_t(fileStat.st_size);
+
+			if(Size == 0) {
+				return;
+			}
+
+			void* mapping = mmap(nullptr, Size, PROT_READ, MAP_PRIVATE, Descriptor, 0);
+
+			Buffer = mapping == MAP_FAILED ? nullptr : static_cast<char const*>(mapping);
+
+			if(Buffer) {
+				madvise(mapping, Size, MADV_SEQUENTIAL);
+			}
+#endif
+
+			[[unlikely]]
+			if(!Buffer) {
+				crash("Could not map " + fileName);
+			}
+		}
+
+		MappedFile(MappedFile const&) = delete;
+		MappedFile& operator=(MappedFile const&) = delete;
+
+		MappedFile(MappedFile&& other) noexcept {
+			Swap(other);
+		}
+
+		MappedFile& operator=(MappedFile&& other) noexcept {
+			Swap(other);
+			return *this;
+		}
+
+		~MappedFile() {
+#if defined(_WIN32)
+			if(Buffer) {
+				UnmapViewOfFile(Buffer);
+			}
+
+			if(MappingHandle) {
+				CloseHandle(MappingHandle);
+			}
+
+			if(FileHandle != INVALID_HANDLE_VALUE) {
+				CloseHandle(FileHandle);
+			}
+#else
+			if(Buffer) {
+				munmap(const_cast<char*>(Buffer), Size);
+			}
+
+			if(Descriptor >= 0) {
+				close(Descriptor);
+			}
+#endif
+		}
+
+		std::string_view Data() const noexcept {
+			return std::string_view(Buffer ? Buffer : "", Size);
+		}
+
+		// Line index is only built on first request, so single-line inputs never pay for it.
+		std::vector<std::string_view> const& Lines() {
+			if(!AreLinesSplit) {
+				splitLines(Data(), LineViews);
+				AreLinesSplit = true;
+			}
+
+			return LineViews;
+		}
+
+	private:
+		void Swap(MappedFile& other) noexcept {
+#if defined(_WIN32)
+			std::swap(FileHandle, other.FileHandle);
+			std::swap(MappingHandle, other.MappingHandle);
+#else
+			std::swap(Descriptor, other.Descriptor);
+#endif
+			std::swap(Buffer, other.Buffer);
+			std::swap(Size, other.Size);
+			std::swap(LineViews, other.LineViews);
+			std::swap(AreLinesSplit, other.AreLinesSplit);
+		}
+
+#if defined(_WIN32)
+		HANDLE FileHandle{ INVALID_HANDLE_VALUE };
+		HANDLE MappingHandle{ nullptr };
+#else
+		int Descriptor{ -1 };
+#endif
+		char const* Buffer{ nullptr };
+		std::size_t Size{ 0 };
+		std::vector<std::string_view> LineViews;
+		bool AreLinesSplit{ false };
+	};
+
+#if defined(AOC_EMBED_INPUT) || defined(AOC_EMBED_INPUT_ARRAY)
+#define AOC_HAS_EMBEDDED_INPUT 1
+
+	namespace embedded {
+
+		// AOC_EMBED_INPUT names the input for #embed, AOC_EMBED_INPUT_ARRAY a header the embed tool
+		// generated from it for compilers without #embed. Both are found like a quoted #include.
+		inline constexpr unsigned char inputBytes[] = {
+#if defined(AOC_EMBED_INPUT_ARRAY)
+#include AOC_EMBED_INPUT_ARRAY
+#else
+#embed AOC_EMBED_INPUT
+#endif
+		};
+
+	}
+#endif
+
+	// The input of a standalone solver: the file mapped at run time, or the bytes compiled into the
+	// binary when it was built with an embedded input, so a rerun of a fixed input does no I/O at all.
+	class PuzzleInput {
+	public:
+#if defined(AOC_HAS_EMBEDDED_INPUT)
+		explicit PuzzleInput([[maybe_unused]] std::string const& fileName) noexcept {}
+
+		std::string_view Data() const noexcept {
+			return std::string_view(reinterpret_cast<char const*>(embedded::inputBytes), sizeof(embedded::inputBytes));
+		}
+#else
+		explicit PuzzleInput(std::string const& fileName) : File(fileName) {}
+
+		std::string_view Data() const noexcept {
+			return File.Data();
+		}
+
+	private:
+		MappedFile File;
+#endif
+	};
+
+}
@@ -0,0 +1,47 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+
+namespace aoc {
+
+	// Appends the text as a quoted JSON string, for the reports of the tools, which hold file names and
+	// solver messages that may contain anything.
+	inline void appendJsonString(std::string& output, std::string_view text) {
+		constexpr std::string_view hexDigits = "0123456789abcdef";
+
+		output += '"';
+
+		for(char const c : text) {
+			switch(c) {
+			case '"':
+				output += "\\\"";
+				break;
+			case '\\':
+				output += "\\\\";
+				break;
+			case '\n':
+				output += "\\n";
+				break;
+			case '\r':
+				output += "\\r";
+				break;
+			case '\t':
+				output += "\\t";
+				break;
+			default:
+				if((unsigned char)(c) < 0x20) {
+					output += "\\u00";
+					output += hexDigits[(unsigned char)(c) >> 4];
+					output += hexDigits[(unsigned char)(c) & 0xf];
+				}
+				else {
+					output += c;
+				}
+			}
+		}
+
+		output += '"';
+	}
+
+}
@@ -0,0 +1,76 @@
+#pragma once
+
+#include <atomic>
+#include <iostream>
+#include <streambuf>
+
+// AOC_LOG_LEVEL picks at compile time what the solvers print besides their answers:
+// 0 nothing, 1 info (progress), 2 debug (per round summaries, maps), 3 trace (every step).
+// Builds with NDEBUG default to 0 and all other builds to 3.
+#ifndef AOC_LOG_LEVEL
+#ifdef NDEBUG
+#define AOC_LOG_LEVEL 0
+#else
+#define AOC_LOG_LEVEL 3
+#endif
+#endif
+
+namespace aoc {
+
+	enum class LogLevel : int {
+		Off = 0,
+		Info = 1,
+		Debug = 2,
+		Trace = 3,
+	};
+
+	inline constexpr LogLevel logLevel = LogLevel(AOC_LOG_LEVEL);
+
+	consteval bool isLogged(LogLevel level) {
+		return level != LogLevel::Off && level <= logLevel;
+	}
+
+	namespace logs {
+
+		class DiscardBuffer : public std::streambuf {
+		protected:
+			int_type overflow(int_type character) override {
+				return traits_type::not_eof(character);
+			}
+
+			std::streamsize xsputn(char const*, std::streamsize count) override {
+				return count;
+			}
+		};
+
+		inline std::atomic<std::ostream*> output{ &std::cout };
+
+		// One stream per thread, as formatting state is kept in the stream.
+		inline std::ostream& discarded() {
+			static DiscardBuffer buffer;
+			thread_local std::ostream stream(&buffer);
+			return stream;
+		}
+
+	}
+
+	// Everything the solvers print besides their answers goes here, std::cout unless discarded. Tools that
+	// run solvers side by side discard it before starting them instead of touching std::cout under them.
+	inline void discardLogs() noexcept {
+		logs::output = nullptr;
+	}
+
+	inline std::ostream& logOutput() {
+		auto* const output = logs::output.load(std::memory_order_relaxed);
+		return output ? *output : logs::discarded();
+	}
+
+}
+
+// The message is a stream expression, e.g. AOC_TRACE("x = " << x << '\n'). Levels that are compiled out
+// do not evaluate their arguments, so logging in hot loops costs nothing in release builds.
+#define AOC_LOG(level, ...) do { if constexpr(aoc::isLogged(level)) { aoc::logOutput() << __VA_ARGS__; } } while(false)
+
+#define AOC_INFO(...) AOC_LOG(aoc::LogLevel::Info, __VA_ARGS__)
+#define AOC_DEBUG(...) AOC_LOG(aoc::LogLevel::Debug, __VA_ARGS__)
+#define AOC_TRACE(...) AOC_LOG(aoc::LogLevel::Trace, __VA_ARGS__)
@@ -0,0 +1,59 @@
+#pragma once
+
+// Counters behind the opt-in memory accounting. With AOC_TRACK_ALLOCATIONS=1 they are fed by the counting
+// operator new/delete of allocations.h and by PageArray; unlike allocations.h this header defines no
+// replacements, so any header may include it.
+#ifndef AOC_TRACK_ALLOCATIONS
+#define AOC_TRACK_ALLOCATIONS 0
+#endif
+
+#include <atomic>
+#include <cstddef>
+
+namespace aoc {
+
+	struct AllocationStats {
+		long long Allocations{};
+		long long Bytes{};
+		long long PeakLiveBytes{};
+	};
+
+	namespace allocations {
+
+		inline std::atomic<long long> count{ 0 };
+		inline std::atomic<long long> bytes{ 0 };
+		inline std::atomic<long long> liveBytes{ 0 };
+		inline std::atomic<long long> peakLiveBytes{ 0 };
+
+		inline void onAllocate(std::size_t requested, std::size_t usable) noexcept {
+			count.fetch_add(1, std::memory_order_relaxed);
+			bytes.fetch_add((long long)(requested), std::memory_order_relaxed);
+
+			auto const live = liveBytes.fetch_add((long long)(usable), std::memory_order_relaxed) + (long long)(usable);
+			auto peak = peakLiveBytes.load(std::memory_order_relaxed);
+
+			while(live > peak && !peakLiveBytes.compare_exchange_weak(peak, live, std::memory_order_relaxed));
+		}
+
+		inline void onDeallocate(std::size_t usable) noexcept {
+			liveBytes.fetch_sub((long long)(usable), std::memory_order_relaxed);
+		}
+
+	}
+
+	inline constexpr bool isTrackingAllocations = AOC_TRACK_ALLOCATIONS != 0;
+
+	inline AllocationStats getAllocationStats() noexcept {
+		return {
+			.Allocations = allocations::count.load(std::memory_order_relaxed),
+			.Bytes = allocations::bytes.load(std::memory_order_relaxed),
+			.PeakLiveBytes = allocations::peakLiveBytes.load(std::memory_order_relaxed),
+		};
+	}
+
+	// Starts a new peak window at whatever is live right now, so each phase reports its own peak.
+	inline void resetAllocationPeak() noexcept {
+		allocations::peakLiveBytes.store(allocations::liveBytes.load(std::memory_order_relaxed), std::memory_order_relaxed);
+	}
+
+}
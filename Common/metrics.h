@@ -0,0 +1,128 @@
+#pragma once
+
+// Named counters and scoped timers for the hot paths. Build with AOC_METRICS=1 to collect them; every
+// value is written as JSON when the program exits, to the file named by the AOC_METRICS_FILE
+// environment variable or to stderr. Without AOC_METRICS the macros expand to nothing.
+#ifndef AOC_METRICS
+#define AOC_METRICS 0
+#endif
+
+#if AOC_METRICS
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <mutex>
+#include <string>
+#include <string_view>
+
+namespace aoc::metrics {
+
+	using Counter = std::atomic<long long>;
+
+	struct Timer {
+		std::atomic<long long> TotalNs{ 0 };
+		std::atomic<long long> Calls{ 0 };
+	};
+
+	class Registry {
+	public:
+		static Registry& Get() {
+			static Registry registry;
+			return registry;
+		}
+
+		// std::map nodes never move, so call sites can keep the returned reference for good.
+		Counter& GetCounter(std::string_view name) {
+			std::lock_guard lock(Mutex);
+			return Counters.try_emplace(std::string(name)).first->second;
+		}
+
+		Timer& GetTimer(std::string_view name) {
+			std::lock_guard lock(Mutex);
+			return Timers.try_emplace(std::string(name)).first->second;
+		}
+
+		~Registry() {
+			char const* const path = std::getenv("AOC_METRICS_FILE");
+
+			if(path && *path) {
+				std::ofstream output(path);
+				Write(output);
+			}
+			else {
+				Write(std::cerr);
+			}
+		}
+
+	private:
+		Registry() = default;
+
+		void Write(std::ostream& output) const {
+			output << "{\n\t\"counters\": {";
+
+			for(bool isFirst = true; auto const& [name, counter] : Counters) {
+				output << (isFirst ? "\n" : ",\n") << "\t\t\"" << name << "\": " << counter.load();
+				isFirst = false;
+			}
+
+			output << "\n\t},\n\t\"timers\": {";
+
+			for(bool isFirst = true; auto const& [name, timer] : Timers) {
+				output << (isFirst ? "\n" : ",\n") << "\t\t\"" << name << "\": { \"calls\": " << timer.Calls.load() << ", \"total_ns\": " << timer.TotalNs.load() << " }";
+				isFirst = false;
+			}
+
+			output << "\n\t}\n}" << std::endl;
+		}
+
+		std::mutex Mutex;
+		std::map<std::string, Counter, std::less<>> Counters;
+		std::map<std::string, Timer, std::less<>> Timers;
+	};
+
+	class ScopedTimer {
+	public:
+		explicit ScopedTimer(Timer& timer) : Target(timer), Start(std::chrono::steady_clock::now()) {}
+
+		ScopedTimer(ScopedTimer const&) = delete;
+		ScopedTimer& operator=(ScopedTimer const&) = delete;
+
+		~ScopedTimer() {
+			auto const elapsed = std::chrono::steady_clock::now() - Start;
+
+			Target.TotalNs.fetch_add(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count(), std::memory_order_relaxed);
+			Target.Calls.fetch_add(1, std::memory_order_relaxed);
+		}
+
+	private:
+		Timer& Target;
+		std::chrono::steady_clock::time_point Start;
+	};
+
+}
+
+#define AOC_METRICS_CONCAT_IMPL(a, b) a##b
+#define AOC_METRICS_CONCAT(a, b) AOC_METRICS_CONCAT_IMPL(a, b)
+
+// The lookup happens once per call site, afterwards a count is a single relaxed atomic add.
+#define AOC_COUNT_ADD(name, amount) do { \
+		static auto& aocCounter = aoc::metrics::Registry::Get().GetCounter(name); \
+		aocCounter.fetch_add((amount), std::memory_order_relaxed); \
+	} while(false)
+
+#define AOC_SCOPED_TIMER(name) \
+	static auto& AOC_METRICS_CONCAT(aocTimer, __LINE__) = aoc::metrics::Registry::Get().GetTimer(name); \
+	aoc::metrics::ScopedTimer AOC_METRICS_CONCAT(aocScopedTimer, __LINE__)(AOC_METRICS_CONCAT(aocTimer, __LINE__))
+
+#else
+
+#define AOC_COUNT_ADD(name, amount) do {} while(false)
+#define AOC_SCOPED_TIMER(name) do {} while(false)
+
+#endif
+
+#define AOC_COUNT(name) AOC_COUNT_ADD(name, 1)
@@ -0,0 +1,140 @@
+#pragma once
+
+#include "crash.h"
+
+#include <bit>
+#include <charconv>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <vector>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define AOC_NUMBERS_SSE2 1
+#endif
+
+namespace aoc {
+
+	// The whole string has to be the number, anything else is a broken input.
+	template<std::integral T = int>
+	T parseInt(std::string_view str) {
+		T result{};
+		auto const [end, error] = std::from_chars(str.data(), str.data() + str.size(), result);
+
+		[[unlikely]]
+		if(error != std::errc{} || end != str.data() + str.size()) {
+			crash("Could not parse int: " + std::string(str));
+		}
+
+		return result;
+	}
+
+	// Every integer of a buffer in one flat array. LineStarts[i] is the index in Values of the first
+	// number on line i and the last entry closes the final line, lines are counted like splitLines does.
+	struct ExtractedInts {
+		std::vector<long long> Values;
+		std::vector<std::size_t> LineStarts;
+
+		std::size_t LineCount() const noexcept {
+			return LineStarts.empty() ? 0 : LineStarts.size() - 1;
+		}
+
+		std::span<long long const> Line(std::size_t line) const noexcept {
+			return std::span<long long const>(Values).subspan(LineStarts[line], LineStarts[line + 1] - LineStarts[line]);
+		}
+	};
+
+	namespace numbers {
+
+		constexpr bool isDigit(char c) {
+			return c >= '0' && c <= '9';
+		}
+
+		// Position of the next digit or '\n' at or after from, data.size() if there is none. Checks 32 bytes
+		// at a time with AVX2 and 16 with SSE2, the tail goes byte by byte.
+		inline std::size_t findDigitOrNewline(std::string_view data, std::size_t from) {
+			auto const* const bytes = data.data();
+
+#if defined(__AVX2__)
+			auto const belowZero = _mm256_set1_epi8('0' - 1);
+			auto const aboveNine = _mm256_set1_epi8('9' + 1);
+			auto const newline = _mm256_set1_epi8('\n');
+
+			for(; from + 32 <= data.size(); from += 32) {
+				auto const chunk = _mm256_loadu_si256(reinterpret_cast<__m256i const*>(bytes + from));
+				auto const digits = _mm256_and_si256(_mm256_cmpgt_epi8(chunk, belowZero), _mm256_cmpgt_epi8(aboveNine, chunk));
+				auto const mask = std::uint32_t(_mm256_movemask_epi8(_mm256_or_si256(digits, _mm256_cmpeq_epi8(chunk, newline))));
+
+				if(mask != 0) {
+					return from + std::size_t(std::countr_zero(mask));
+				}
+			}
+#elif defined(AOC_NUMBERS_SSE2)
+			auto const belowZero = _mm_set1_epi8('0' - 1);
+			auto const aboveNine = _mm_set1_epi8('9' + 1);
+			auto const newline = _mm_set1_epi8('\n');
+
+			for(; from + 16 <= data.size(); from += 16) {
+				auto const chunk = _mm_loadu_si128(reinterpret_cast<__m128i const*>(bytes + from));
+				auto const digits = _mm_and_si128(_mm_cmpgt_epi8(chunk, belowZero), _mm_cmplt_epi8(chunk, aboveNine));
+				auto const mask = std::uint32_t(_mm_movemask_epi8(_mm_or_si128(digits, _mm_cmpeq_epi8(chunk, newline))));
+
+				if(mask != 0) {
+					return from + std::size_t(std::countr_zero(mask));
+				}
+			}
+#endif
+
+			for(; from < data.size(); ++from) {
+				if(isDigit(bytes[from]) || bytes[from] == '\n') {
+					return from;
+				}
+			}
+
+			return data.size();
+		}
+
+	}
+
+	// Collects every run of digits in data, a '-' right in front of a run makes it negative. The output
+	// is cleared first, so reusing it across calls keeps its capacity.
+	inline void extractInts(std::string_view data, ExtractedInts& result) {
+		result.Values.clear();
+		result.LineStarts.clear();
+		result.LineStarts.emplace_back(0);
+
+		for(std::size_t position = numbers::findDigitOrNewline(data, 0); position < data.size(); position = numbers::findDigitOrNewline(data, position)) {
+			if(data[position] == '\n') {
+				result.LineStarts.emplace_back(result.Values.size());
+				++position;
+				continue;
+			}
+
+			auto const start = position > 0 && data[position - 1] == '-' ? position - 1 : position;
+
+			long long value{};
+			auto const [end, error] = std::from_chars(data.data() + start, data.data() + data.size(), value);
+
+			[[unlikely]]
+			if(error != std::errc{}) {
+				crash("Integer out of range at offset " + std::to_string(start));
+			}
+
+			result.Values.emplace_back(value);
+			position = std::size_t(end - data.data());
+		}
+
+		// an unterminated last line still counts, a trailing '\n' does not open another one
+		if(!data.empty() && data.back() != '\n') {
+			result.LineStarts.emplace_back(result.Values.size());
+		}
+	}
+
+}
@@ -0,0 +1,198 @@
+#pragma once
+
+#include "crash.h"
+#include "memory.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+#if defined(_WIN32)
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#endif
+
+namespace aoc {
+
+	namespace pages {
+
+		inline constexpr std::size_t hugePageSize = std::size_t(2) << 20;
+
+		inline std::size_t roundUp(std::size_t bytes, std::size_t multiple) noexcept {
+			return (bytes + multiple - 1) / multiple * multiple;
+		}
+
+		// Zeroed memory straight from the OS. Big blocks ask for huge pages: on Linux transparent huge pages
+		// through madvise, on Windows large pages, which need the "Lock pages in memory" privilege and
+		// quietly fall back to normal pages without it.
+		inline void* map(std::size_t& bytes) {
+#if defined(_WIN32)
+			if(std::size_t const largePage = GetLargePageMinimum(); largePage != 0 && bytes >= largePage) {
+				auto const largeBytes = roundUp(bytes, largePage);
+
+				if(void* const memory = VirtualAlloc(nullptr, largeBytes, MEM_RESERVE | MEM_COMMIT | MEM_LARGE_PAGES, PAGE_READWRITE)) {
+					bytes = largeBytes;
+					return memory;
+				}
+			}
+
+			void* const memory = VirtualAlloc(nullptr, bytes, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE);
+
+			[[unlikely]]
+			if(!memory) {
+				crash("Could not allocate " + std::to_string(bytes) + " bytes");
+			}
+
+			return memory;
+#else
+			bool const isHuge = bytes >= hugePageSize;
+
+			if(isHuge) {
+				bytes = roundUp(bytes, hugePageSize);
+			}
+
+			// mmap only aligns to normal pages, so huge blocks map one huge page more and trim the slack at both
+			// ends; an unaligned block would leave its first and last huge page partial and never backed
+			auto const mappedBytes = isHuge ? bytes + hugePageSize : bytes;
+			void* const mapped = mmap(nullptr, mappedBytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+
+			[[unlikely]]
+			if(mapped == MAP_FAILED) {
+				crash("Could not allocate " + std::to_string(bytes) + " bytes");
+			}
+
+			void* memory = mapped;
+
+			if(isHuge) {
+				auto const base = reinterpret_cast<std::uintptr_t>(mapped);
+				auto const head = roundUp(base, hugePageSize) - base;
+				auto* const aligned = static_cast<char*>(mapped) + head;
+
+				if(head > 0) {
+					munmap(mapped, head);
+				}
+
+				munmap(aligned + bytes, hugePageSize - head);
+
+				memory = aligned;
+			}
+
+#if defined(MADV_HUGEPAGE)
+			if(isHuge) {
+				// only a hint, the kernel may not have huge pages to give
+				madvise(memory, bytes, MADV_HUGEPAGE);
+			}
+#endif
+
+			return memory;
+#endif
+		}
+
+		inline void unmap(void* memory, [[maybe_unused]] std::size_t bytes) noexcept {
+#if defined(_WIN32)
+			VirtualFree(memory, 0, MEM_RELEASE);
+#else
+			munmap(memory, bytes);
+#endif
+		}
+
+		// Bypasses operator new, so the page tables are counted like heap blocks here, with the rounded up
+		// size as what is live.
+		inline void* allocate(std::size_t& bytes) {
+			auto const requested = bytes;
+			void* const memory = map(bytes);
+
+			if constexpr(isTrackingAllocations) {
+				allocations::onAllocate(requested, bytes);
+			}
+
+			return memory;
+		}
+
+		inline void release(void* memory, std::size_t bytes) noexcept {
+			if constexpr(isTrackingAllocations) {
+				allocations::onDeallocate(bytes);
+			}
+
+			unmap(memory, bytes);
+		}
+
+	}
+
+	// Fixed-size, zero-initialised array of plain values for the big tables, backed by huge pages where the
+	// OS provides them, so sweeping a table of hundreds of megabytes costs far fewer TLB misses.
+	template<typename T>
+	class PageArray {
+		static_assert(std::is_trivially_copyable_v<T> && std::is_trivially_destructible_v<T>);
+	public:
+		PageArray() = default;
+
+		explicit PageArray(std::size_t size) : Size(size), Bytes(size * sizeof(T)) {
+			if(Bytes > 0) {
+				Data = static_cast<T*>(pages::allocate(Bytes));
+			}
+		}
+
+		PageArray(PageArray&& other) noexcept :
+			Data(std::exchange(other.Data, nullptr)), Size(std::exchange(other.Size, 0)), Bytes(std::exchange(other.Bytes, 0))
+		{
+		}
+
+		PageArray& operator=(PageArray&& other) noexcept {
+			if(this != &other) {
+				Release();
+				Data = std::exchange(other.Data, nullptr);
+				Size = std::exchange(other.Size, 0);
+				Bytes = std::exchange(other.Bytes, 0);
+			}
+
+			return *this;
+		}
+
+		PageArray(PageArray const&) = delete;
+		PageArray& operator=(PageArray const&) = delete;
+
+		~PageArray() {
+			Release();
+		}
+
+		T& operator[](std::size_t index) noexcept { return Data[index]; }
+		T const& operator[](std::size_t index) const noexcept { return Data[index]; }
+
+		T* GetData() noexcept { return Data; }
+		T const* GetData() const noexcept { return Data; }
+
+		std::size_t GetSize() const noexcept { return Size; }
+
+		std::span<T> Span(std::size_t offset, std::size_t count) noexcept {
+			return std::span<T>(Data + offset, count);
+		}
+
+		std::span<T const> Span(std::size_t offset, std::size_t count) const noexcept {
+			return std::span<T const>(Data + offset, count);
+		}
+
+	private:
+		void Release() noexcept {
+			if(Data) {
+				pages::release(Data, Bytes);
+				Data = nullptr;
+			}
+		}
+
+		T* Data{};
+		std::size_t Size{};
+		std::size_t Bytes{};
+	};
+
+}
@@ -0,0 +1,120 @@
+#pragma once
+
+#include "crash.h"
+
+#include <charconv>
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <system_error>
+
+namespace aoc {
+
+	// Single pass over one input line that pulls fields straight out of the buffer, a cheap stand-in for
+	// std::regex. Patterns are literal text where "{}" reads the next field (int or identifier, picked by
+	// the argument type) and a character followed by '?' is optional, e.g.
+	//     scanner.Scan("Valve {} has flow rate={}; tunnels? leads? to valves? ", name, flow);
+	// Identifiers are runs of ASCII letters and stay views into the line. A mismatch crashes with the
+	// line and column of the first character that did not fit.
+	class Scanner {
+	public:
+		Scanner(std::string_view line, std::size_t lineNumber) : Line(line), LineNumber(lineNumber) {}
+
+		template<typename... Fields>
+		void Scan(std::string_view pattern, Fields&... fields) {
+			(ScanField(pattern, fields), ...);
+			Expect(pattern);
+		}
+
+		// Matches the literal part of a pattern, without fields.
+		void Expect(std::string_view literal) {
+			for(std::size_t i = 0; i < literal.size(); ++i) {
+				bool const isOptional = i + 1 < literal.size() && literal[i + 1] == '?';
+
+				if(Position < Line.size() && Line[Position] == literal[i]) {
+					++Position;
+				}
+				else if(!isOptional) {
+					Fail("expected \"" + std::string(literal.substr(i)) + "\"");
+				}
+
+				if(isOptional) {
+					++i;
+				}
+			}
+		}
+
+		// Consumes the literal if the line continues with it, for separators of variable length lists.
+		bool Skip(std::string_view literal) {
+			if(Line.substr(Position).starts_with(literal)) {
+				Position += literal.size();
+				return true;
+			}
+
+			return false;
+		}
+
+		void Read(int& value) {
+			auto const* const begin = Line.data() + Position;
+			auto const [end, error] = std::from_chars(begin, Line.data() + Line.size(), value);
+
+			[[unlikely]]
+			if(error != std::errc{}) {
+				Fail(error == std::errc::result_out_of_range ? "integer out of range" : "expected an integer");
+			}
+
+			Position += std::size_t(end - begin);
+		}
+
+		void Read(std::string_view& identifier) {
+			auto const start = Position;
+
+			while(Position < Line.size() && isLetter(Line[Position])) {
+				++Position;
+			}
+
+			[[unlikely]]
+			if(Position == start) {
+				Fail("expected an identifier");
+			}
+
+			identifier = Line.substr(start, Position - start);
+		}
+
+		void ExpectEnd() {
+			[[unlikely]]
+			if(Position != Line.size()) {
+				Fail("expected the end of the line");
+			}
+		}
+
+		[[noreturn]]
+		void Fail(std::string_view what) const {
+			crash(std::to_string(LineNumber) + ":" + std::to_string(Position + 1) + ": " + std::string(what) + "\n" + std::string(Line) + "\n" + std::string(Position, ' ') + "^");
+		}
+
+	private:
+		static constexpr bool isLetter(char c) {
+			return (c >= 'A' && c <= 'Z') || (c >= 'a' && c <= 'z');
+		}
+
+		template<typename Field>
+		void ScanField(std::string_view& pattern, Field& field) {
+			auto const placeholder = pattern.find("{}");
+
+			[[unlikely]]
+			if(placeholder == std::string_view::npos) {
+				crash("Scanner pattern has fewer fields than arguments");
+			}
+
+			Expect(pattern.substr(0, placeholder));
+			pattern.remove_prefix(placeholder + 2);
+			Read(field);
+		}
+
+		std::string_view Line;
+		std::size_t LineNumber;
+		std::size_t Position{ 0 };
+	};
+
+}
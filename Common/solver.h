@@ -0,0 +1,76 @@
+#pragma once
+
+#include <array>
+#include <cstdio>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <variant>
+
+namespace aoc {
+
+	// Empty when a solver does not compute that part (the "a" and "b" directories only solve one each).
+	using Answer = std::variant<std::monostate, long long, std::string>;
+
+	struct Answers {
+		Answer Part1{};
+		Answer Part2{};
+	};
+
+	using SolveFunction = Answers(*)(std::string_view input);
+
+	// Solvers that handle one line at a time can also read from a stream in chunks, so inputs larger
+	// than memory can be piped in.
+	using StreamFunction = Answers(*)(std::FILE* stream);
+
+	struct Solver {
+		std::string_view Id;
+		std::string_view Directory;
+		SolveFunction Solve;
+		StreamFunction Stream{ nullptr };
+		// Part of the result cache and checkpoint keys: bump it whenever a change could alter the answers for
+		// some input or the layout of the progress a solver checkpoints.
+		int Version{ 1 };
+	};
+
+	// Solvers with a separate parsing step call markParsed() once it is done and the ones with a final
+	// combining step call enterPhase(Phase::Combine) before it, so the benchmark can attribute time and
+	// memory to each phase. Work before the first boundary a solver never marks counts as solving.
+	enum class Phase : int {
+		Parse,
+		Solve,
+		Combine,
+	};
+
+	inline constexpr std::array<std::string_view, 3> phaseNames{ "parse", "solve", "combine" };
+
+	// Only set while something is measuring the current thread, so marking a phase is a single branch otherwise.
+	inline thread_local void(*phaseListener)(Phase phase) = nullptr;
+
+	inline void enterPhase(Phase phase) {
+		if(phaseListener) {
+			phaseListener(phase);
+		}
+	}
+
+	inline void markParsed() {
+		enterPhase(Phase::Solve);
+	}
+
+	inline std::string toString(Answer const& answer) {
+		return std::visit([](auto const& value) -> std::string {
+			using T = std::decay_t<decltype(value)>;
+
+			if constexpr(std::is_same_v<T, std::monostate>) {
+				return "-";
+			}
+			else if constexpr(std::is_same_v<T, long long>) {
+				return std::to_string(value);
+			}
+			else {
+				return value;
+			}
+		}, answer);
+	}
+
+}
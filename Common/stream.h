@@ -0,0 +1,313 @@
+#pragma once
+
+#include "crash.h"
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+namespace aoc {
+
+	inline constexpr std::size_t defaultChunkSize = std::size_t(1) << 16;
+
+	// "-" as the first argument makes a standalone solver stream its input from stdin instead of input.txt.
+	inline bool isStreamRequested(int argc, char** argv) {
+		return argc > 1 && std::string_view(argv[1]) == "-";
+	}
+
+	// Fixed-size pieces of a stream (stdin, a pipe), for inputs that are one huge line. Each chunk is
+	// only valid until the next call.
+	class ChunkReader {
+	public:
+		explicit ChunkReader(std::FILE* file, std::size_t chunkSize = defaultChunkSize) : File(file), Buffer(chunkSize) {}
+
+		bool Next(std::string_view& chunk) {
+			auto const size = std::fread(Buffer.data(), 1, Buffer.size(), File);
+
+			if(size == 0) {
+				[[unlikely]]
+				if(std::ferror(File)) {
+					crash("Could not read the input stream");
+				}
+
+				return false;
+			}
+
+			chunk = std::string_view(Buffer.data(), size);
+			return true;
+		}
+
+	private:
+		std::FILE* File;
+		std::vector<char> Buffer;
+	};
+
+	// Like ChunkReader, but a reader thread fills the next buffers while the current chunk is being parsed,
+	// so reading and parsing overlap. With the default two buffers the reader is always one chunk ahead.
+	// The thread only waits on I/O, so it is a plain thread of its own rather than a task pool worker.
+	class ChunkPrefetcher {
+	public:
+		explicit ChunkPrefetcher(std::FILE* file, std::size_t chunkSize = defaultChunkSize, std::size_t bufferCount = 2) :
+			File(file), Buffers(std::max<std::size_t>(2, bufferCount), std::vector<char>(chunkSize)), Sizes(Buffers.size())
+		{
+			Reader = std::thread([this]() { ReadLoop(); });
+		}
+
+		ChunkPrefetcher(ChunkPrefetcher const&) = delete;
+		ChunkPrefetcher& operator=(ChunkPrefetcher const&) = delete;
+
+		~ChunkPrefetcher() {
+			{
+				std::lock_guard lock(Mutex);
+				IsStopping = true;
+			}
+
+			CanRead.notify_one();
+			Reader.join();
+		}
+
+		// The chunk stays valid until the next call, which hands its buffer back to the reader.
+		bool Next(std::string_view& chunk) {
+			std::unique_lock lock(Mutex);
+
+			if(IsChunkHeld) {
+				IsChunkHeld = false;
+				++Consumed;
+				CanRead.notify_one();
+			}
+
+			CanConsume.wait(lock, [this]() { return Produced > Consumed || IsEndOfInput; });
+
+			if(Produced == Consumed) {
+				[[unlikely]]
+				if(HasFailed) {
+					crash("Could not read the input stream");
+				}
+
+				return false;
+			}
+
+			auto const slot = std::size_t(Consumed % Buffers.size());
+
+			chunk = std::string_view(Buffers[slot].data(), Sizes[slot]);
+			IsChunkHeld = true;
+
+			return true;
+		}
+
+	private:
+		void ReadLoop() {
+			while(true) {
+				std::size_t slot;
+
+				{
+					std::unique_lock lock(Mutex);
+
+					CanRead.wait(lock, [this]() { return IsStopping || Produced - Consumed < Buffers.size(); });
+
+					if(IsStopping) {
+						return;
+					}
+
+					slot = std::size_t(Produced % Buffers.size());
+				}
+
+				auto const size = std::fread(Buffers[slot].data(), 1, Buffers[slot].size(), File);
+
+				{
+					std::lock_guard lock(Mutex);
+
+					if(size == 0) {
+						HasFailed = std::ferror(File) != 0;
+						IsEndOfInput = true;
+					}
+					else {
+						Sizes[slot] = size;
+						++Produced;
+					}
+				}
+
+				CanConsume.notify_one();
+
+				if(size == 0) {
+					return;
+				}
+			}
+		}
+
+		std::FILE* File;
+		std::vector<std::vector<char>> Buffers;
+		std::vector<std::size_t> Sizes;
+
+		std::mutex Mutex;
+		std::condition_variable CanRead;
+		std::condition_variable CanConsume;
+		unsigned long long Produced{ 0 };
+		unsigned long long Consumed{ 0 };
+		bool IsChunkHeld{ false };
+		bool IsEndOfInput{ false };
+		bool HasFailed{ false };
+		bool IsStopping{ false };
+
+		std::thread Reader;
+	};
+
+	// Line by line over either a buffer that is already in memory or a stream read in chunks. Lines are
+	// split like splitLines does and stay valid until the next call; for a stream only the chunk and the
+	// line it ends in are held, so memory is bounded by the longest line instead of the input size.
+	class LineReader {
+	public:
+		explicit LineReader(std::string_view data) : Pending(data), IsEndOfInput(true) {}
+
+		explicit LineReader(std::FILE* file, std::size_t chunkSize = defaultChunkSize) : File(file), Buffer(chunkSize) {}
+
+		// Lines are handed out in place in the prefetched chunks; only a line that crosses into the next
+		// chunk is copied together.
+		explicit LineReader(ChunkPrefetcher& chunks) : Chunks(&chunks) {}
+
+		bool Next(std::string_view& line) {
+			if(Chunks) {
+				return NextPrefetched(line);
+			}
+
+			auto lineEnd = Pending.find('\n');
+
+			while(lineEnd == std::string_view::npos && !IsEndOfInput) {
+				auto const searched = Pending.size();
+
+				Refill();
+
+				lineEnd = Pending.find('\n', searched);
+			}
+
+			if(lineEnd == std::string_view::npos) {
+				if(Pending.empty()) {
+					return false;
+				}
+
+				lineEnd = Pending.size();
+			}
+
+			line = Pending.substr(0, lineEnd);
+			Pending.remove_prefix(lineEnd < Pending.size() ? lineEnd + 1 : lineEnd);
+
+			trimCarriageReturn(line);
+
+			return true;
+		}
+
+	private:
+		static void trimCarriageReturn(std::string_view& line) noexcept {
+			if(!line.empty() && line.back() == '\r') {
+				line.remove_suffix(1);
+			}
+		}
+
+		bool NextPrefetched(std::string_view& line) {
+			auto lineEnd = Pending.find('\n');
+
+			if(lineEnd == std::string_view::npos) {
+				Carry.assign(Pending);
+				Pending = {};
+
+				for(std::string_view chunk;;) {
+					if(!Chunks->Next(chunk)) {
+						if(Carry.empty()) {
+							return false;
+						}
+
+						line = Carry;
+						trimCarriageReturn(line);
+
+						return true;
+					}
+
+					lineEnd = chunk.find('\n');
+
+					if(lineEnd != std::string_view::npos) {
+						Carry.append(chunk.substr(0, lineEnd));
+						Pending = chunk.substr(lineEnd + 1);
+
+						line = Carry;
+						trimCarriageReturn(line);
+
+						return true;
+					}
+
+					Carry.append(chunk);
+				}
+			}
+
+			line = Pending.substr(0, lineEnd);
+			Pending.remove_prefix(lineEnd + 1);
+
+			trimCarriageReturn(line);
+
+			return true;
+		}
+
+		// Moves the unfinished line to the front of the buffer and reads the next chunk behind it. A line
+		// longer than the buffer doubles it.
+		void Refill() {
+			auto const kept = Pending.size();
+			auto const keptOffset = kept > 0 ? std::size_t(Pending.data() - Buffer.data()) : 0;
+
+			if(kept == Buffer.size()) {
+				Buffer.resize(Buffer.size() * 2);
+			}
+
+			if(kept > 0 && keptOffset > 0) {
+				std::memmove(Buffer.data(), Buffer.data() + keptOffset, kept);
+			}
+
+			auto const size = std::fread(Buffer.data() + kept, 1, Buffer.size() - kept, File);
+
+			if(size == 0) {
+				[[unlikely]]
+				if(std::ferror(File)) {
+					crash("Could not read the input stream");
+				}
+
+				IsEndOfInput = true;
+			}
+
+			Pending = std::string_view(Buffer.data(), kept + size);
+		}
+
+		std::FILE* File{ nullptr };
+		ChunkPrefetcher* Chunks{ nullptr };
+		std::vector<char> Buffer;
+		std::string Carry;
+		std::string_view Pending;
+		bool IsEndOfInput{ false };
+	};
+
+	// For line-at-a-time solvers whose inputs get large: the stream is read a chunk ahead on a separate
+	// thread while the current chunk is parsed, and solveLines is called with a LineReader over it.
+	template<typename SolveLines>
+	auto solvePrefetchedLines(std::FILE* file, SolveLines&& solveLines) {
+		ChunkPrefetcher chunks(file);
+		LineReader lines(chunks);
+		return solveLines(lines);
+	}
+
+	// For solvers that need the whole input at once but are fed from a stream.
+	inline std::string readAll(std::FILE* file) {
+		std::string data;
+		ChunkReader chunks(file);
+
+		for(std::string_view chunk; chunks.Next(chunk);) {
+			data += chunk;
+		}
+
+		return data;
+	}
+
+}
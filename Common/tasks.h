@@ -0,0 +1,347 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstdlib>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace aoc {
+
+	namespace tasks {
+
+		// 0 picks AOC_THREADS from the environment and then the hardware concurrency.
+		inline std::atomic<int> requestedThreadCount{ 0 };
+
+		inline int resolveThreadCount() {
+			if(int const requested = requestedThreadCount.load(); requested > 0) {
+				return requested;
+			}
+
+			if(char const* const fromEnvironment = std::getenv("AOC_THREADS"); fromEnvironment && *fromEnvironment) {
+				if(int const count = std::atoi(fromEnvironment); count > 0) {
+					return count;
+				}
+			}
+
+			return std::max(1, int(std::thread::hardware_concurrency()));
+		}
+
+	}
+
+	// Work-stealing pool: every worker owns a deque, takes its own newest task first and steals the oldest
+	// ones of the others when it runs dry. Threads outside the pool hand work in through a shared queue.
+	// A thread that waits for a task group keeps running tasks meanwhile, so nesting never deadlocks.
+	class TaskPool {
+	public:
+		using Task = std::function<void()>;
+
+		// Created on first use with the configured thread count; the calling thread counts as one of them.
+		static TaskPool& Get() {
+			static TaskPool pool(tasks::resolveThreadCount());
+			return pool;
+		}
+
+		explicit TaskPool(int threadCount) : Queues(std::size_t(std::max(1, threadCount))) {
+			for(int worker = 0; worker + 1 < threadCount; ++worker) {
+				Workers.emplace_back([this, worker]() { WorkerLoop(worker); });
+			}
+		}
+
+		TaskPool(TaskPool const&) = delete;
+		TaskPool& operator=(TaskPool const&) = delete;
+
+		~TaskPool() {
+			{
+				std::lock_guard lock(SleepMutex);
+				IsStopping = true;
+			}
+
+			WakeUp.notify_all();
+
+			for(auto& worker : Workers) {
+				worker.join();
+			}
+		}
+
+		int GetThreadCount() const noexcept {
+			return int(Workers.size()) + 1;
+		}
+
+		void Push(Task task) {
+			auto& queue = Queues[GetOwnQueue()];
+
+			{
+				std::lock_guard lock(queue.Mutex);
+				queue.Tasks.emplace_back(std::move(task));
+			}
+
+			QueuedTasks.fetch_add(1, std::memory_order_release);
+
+			{
+				std::lock_guard lock(SleepMutex);
+			}
+
+			WakeUp.notify_one();
+		}
+
+		// Runs one queued task on the calling thread, false when there was nothing to do.
+		bool RunOne() {
+			Task task;
+
+			if(!TryTake(task)) {
+				return false;
+			}
+
+			task();
+			return true;
+		}
+
+		// Sleeps until isDone() holds or a task is queued. Whoever makes isDone() true has to call WakeAll().
+		template<typename Predicate>
+		void WaitForWork(Predicate&& isDone) {
+			std::unique_lock lock(SleepMutex);
+
+			WakeUp.wait(lock, [&]() { return isDone() || QueuedTasks.load(std::memory_order_acquire) > 0; });
+		}
+
+		void WakeAll() {
+			{
+				std::lock_guard lock(SleepMutex);
+			}
+
+			WakeUp.notify_all();
+		}
+
+	private:
+		struct Queue {
+			std::mutex Mutex;
+			std::deque<Task> Tasks;
+		};
+
+		// Workers use their own queue, every other thread shares the last one.
+		std::size_t GetOwnQueue() const noexcept {
+			return CurrentPool == this ? CurrentWorker : Queues.size() - 1;
+		}
+
+		bool TryTake(Task& task) {
+			if(QueuedTasks.load(std::memory_order_acquire) == 0) {
+				return false;
+			}
+
+			auto const own = GetOwnQueue();
+
+			for(std::size_t i = 0; i < Queues.size(); ++i) {
+				auto const victim = (own + i) % Queues.size();
+				auto& queue = Queues[victim];
+
+				std::lock_guard lock(queue.Mutex);
+
+				if(queue.Tasks.empty()) {
+					continue;
+				}
+
+				if(victim == own) {
+					task = std::move(queue.Tasks.back());
+					queue.Tasks.pop_back();
+				}
+				else {
+					task = std::move(queue.Tasks.front());
+					queue.Tasks.pop_front();
+				}
+
+				QueuedTasks.fetch_sub(1, std::memory_order_relaxed);
+				return true;
+			}
+
+			return false;
+		}
+
+		void WorkerLoop(int worker) {
+			CurrentPool = this;
+			CurrentWorker = std::size_t(worker);
+
+			while(true) {
+				if(RunOne()) {
+					continue;
+				}
+
+				std::unique_lock lock(SleepMutex);
+
+				WakeUp.wait(lock, [this]() { return IsStopping || QueuedTasks.load(std::memory_order_acquire) > 0; });
+
+				if(IsStopping) {
+					return;
+				}
+			}
+		}
+
+		static inline thread_local TaskPool const* CurrentPool{ nullptr };
+		static inline thread_local std::size_t CurrentWorker{ 0 };
+
+		std::vector<Queue> Queues;
+		std::vector<std::thread> Workers;
+		std::atomic<long long> QueuedTasks{ 0 };
+		std::mutex SleepMutex;
+		std::condition_variable WakeUp;
+		bool IsStopping{ false };
+	};
+
+	// Has to be called before the pool is first used, e.g. while parsing the command line.
+	inline void setThreadCount(int count) {
+		tasks::requestedThreadCount.store(count);
+	}
+
+	// Tasks that are waited for together. The first exception thrown by a task is rethrown by Wait().
+	// Without worker threads a task runs right away, so single threaded runs keep the sequential order.
+	class TaskGroup {
+	public:
+		explicit TaskGroup(TaskPool& pool = TaskPool::Get()) : Pool(pool) {}
+
+		TaskGroup(TaskGroup const&) = delete;
+		TaskGroup& operator=(TaskGroup const&) = delete;
+
+		~TaskGroup() {
+			WaitForPending();
+		}
+
+		template<typename Function>
+		void Run(Function&& function) {
+			if(Pool.GetThreadCount() == 1) {
+				function();
+				return;
+			}
+
+			Pending.fetch_add(1, std::memory_order_relaxed);
+
+			Pool.Push([this, &pool = Pool, function = std::forward<Function>(function)]() mutable {
+				try {
+					function();
+				}
+				catch(...) {
+					std::lock_guard lock(ErrorMutex);
+
+					if(!Error) {
+						Error = std::current_exception();
+					}
+				}
+
+				// The group may be gone as soon as the last task is counted down, so only the pool is touched after.
+				if(Pending.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+					pool.WakeAll();
+				}
+			});
+		}
+
+		void Wait() {
+			WaitForPending();
+
+			if(Error) {
+				std::rethrow_exception(std::exchange(Error, nullptr));
+			}
+		}
+
+	private:
+		void WaitForPending() {
+			while(Pending.load(std::memory_order_acquire) > 0) {
+				if(!Pool.RunOne()) {
+					Pool.WaitForWork([this]() { return Pending.load(std::memory_order_acquire) == 0; });
+				}
+			}
+		}
+
+		TaskPool& Pool;
+		std::atomic<long long> Pending{ 0 };
+		std::mutex ErrorMutex;
+		std::exception_ptr Error;
+	};
+
+	namespace tasks {
+
+		// The split only depends on the range and the grain, never on the thread count, which is what keeps
+		// parallelReduce deterministic.
+		inline long long getChunkSize(long long begin, long long end, long long grain) {
+			constexpr long long defaultChunkCount = 256;
+
+			if(grain > 0) {
+				return grain;
+			}
+
+			return std::max(1LL, (end - begin + defaultChunkCount - 1) / defaultChunkCount);
+		}
+
+	}
+
+	// body(i) for every i in [begin, end), in chunks of grain indices (or about 256 chunks when grain is 0).
+	template<typename Body>
+	void parallelFor(long long begin, long long end, Body&& body, long long grain = 0) {
+		if(begin >= end) {
+			return;
+		}
+
+		auto const chunkSize = tasks::getChunkSize(begin, end, grain);
+
+		TaskGroup group;
+
+		for(long long chunkBegin = begin; chunkBegin < end; chunkBegin += chunkSize) {
+			group.Run([&body, chunkBegin, chunkEnd = std::min(end, chunkBegin + chunkSize)]() {
+				for(long long i = chunkBegin; i < chunkEnd; ++i) {
+					body(i);
+				}
+			});
+		}
+
+		group.Wait();
+	}
+
+	// Every chunk folds its indices into its own accumulator with body(accumulator, i), then the chunks are
+	// combined from left to right. The chunks do not depend on the thread count either, so even a
+	// non-associative combine gives the same result on any machine.
+	template<typename T, typename Body, typename Combine>
+	T parallelReduce(long long begin, long long end, T identity, Body&& body, Combine&& combine, long long grain = 0) {
+		if(begin >= end) {
+			return identity;
+		}
+
+		auto const chunkSize = tasks::getChunkSize(begin, end, grain);
+		auto const chunkCount = std::size_t((end - begin + chunkSize - 1) / chunkSize);
+
+		std::vector<T> partials(chunkCount, identity);
+
+		{
+			TaskGroup group;
+
+			for(std::size_t chunk = 0; chunk < chunkCount; ++chunk) {
+				group.Run([&, chunk]() {
+					auto const chunkBegin = begin + (long long)(chunk) * chunkSize;
+					auto const chunkEnd = std::min(end, chunkBegin + chunkSize);
+
+					T accumulator = identity;
+
+					for(long long i = chunkBegin; i < chunkEnd; ++i) {
+						body(accumulator, i);
+					}
+
+					partials[chunk] = std::move(accumulator);
+				});
+			}
+
+			group.Wait();
+		}
+
+		T result = std::move(identity);
+
+		for(auto& partial : partials) {
+			result = combine(std::move(result), std::move(partial));
+		}
+
+		return result;
+	}
+
+}
@@ -1,8 +1,12 @@
 ﻿#include "game.h"
 
+#include <algorithm>
 #include <iostream>
+
+#if defined(_WIN32)
 #include <io.h>
 #include <fcntl.h>
+#endif
 
 void Game::DropShape(TShape const& shape) {
 	
@@ -13,7 +17,9 @@ void Game::DropShape(TShape const& shape) {
 
 
 int Game::GetFreeY(TShape const& shape) {
+#if defined(_WIN32)
 	 _setmode(_fileno(stdout), _O_U16TEXT);
+#endif
 
 	int const shapeHeight = int(shape.size());
 	int const shapeWidth = int(shape.front().size());
@@ -21,7 +27,7 @@ int Game::GetFreeY(TShape const& shape) {
 	for(int y = this->Height - 1; y >= shapeHeight - 1; --y) {
 		for(int yOff = 0; yOff < shapeHeight; ++yOff) {
 			for(int x = 0; x < shapeWidth; ++x) {
-				if(Board[y - yOff][x] == 1 && shape[yOff][x] == 1) {
+				if(Board(x, y - yOff) == 1 && shape[yOff][x] == 1) {
 					return y + 1;
 				}
 			}
@@ -34,7 +40,7 @@ int Game::GetFreeY(TShape const& shape) {
 void Game::InsertShapeAt(TShape const& shape, int y) {
 	for(int yOff = 0; yOff < shape.size(); ++yOff) {
 		for(int xOff = 0; xOff < shape.front().size(); ++xOff) {
-			Board[y - yOff][xOff] |= shape[yOff][xOff];
+			Board(xOff, y - yOff) |= shape[yOff][xOff];
 		}
 	}
 
@@ -43,14 +49,17 @@ void Game::InsertShapeAt(TShape const& shape, int y) {
 
 void Game::RemoveFullLines(int yFrom, int yTo) {
 	for(int y = yFrom; y < yTo; ++y) {
-		for(auto item : Board[y]) {
+		for(auto item : Board.Row(y)) {
 			if(item == 0) {
 				goto ContinueOuter;
 			}
 		}
 
-		Board.erase(std::next(Board.begin(), y));
-		Board.emplace_back(this->Width);
+		for(int row = y; row + 1 < this->Height; ++row) {
+			std::ranges::copy(Board.Row(row + 1), Board.Row(row).begin());
+		}
+
+		std::ranges::fill(Board.Row(this->Height - 1), 0);
 		--y;
 		++Score;
 
@@ -65,7 +74,7 @@ void Game::PrintBoard() {
 
 	for(; y >= 0; --y) {
 		for(int x = 0; x < this->Width; ++x) {
-			if(Board[y][x]) {
+			if(Board(x, y)) {
 				goto BreakOuter;
 			}
 		}
@@ -75,7 +84,7 @@ BreakOuter: {}
 
 	for(; y >= 0; --y) {
 		for(int x = 0; x < this->Width; ++x) {
-			std::wcout << (Board[y][x] ? L'◘' : L'_');
+			std::wcout << (Board(x, y) ? L'◘' : L'_');
 		}
 
 		std::wcout << '\n';
@@ -1,18 +1,18 @@
 #pragma once
 
 #include <array>
-#include <vector>
+
+#include "../../Common/grid.h"
 
 class Game {
 public:
 	using TShape = std::array<std::array<int, 6>, 6>;
-	using TLine = std::vector<int>;
-	using TBoard = std::vector<TLine>;
+	using TBoard = aoc::Grid2D<int>;
 
-	Game(int width, int height) noexcept :
+	Game(int width, int height) :
 		Width(width),
 		Height(height),
-		Board(TBoard(height, TLine(width))) 
+		Board(width, height) 
 	{}
 	
 	void DropShape(TShape const& shape);
@@ -4,11 +4,16 @@
 #include "game.h"
 
 #include <cassert>
-#include <fstream>
 #include <string>
 #include <iostream>
 #include <unordered_map>
 
+#include "../../Common/crash.h"
+#include "../../Common/input.h"
+#include "../../Common/solver.h"
+
+namespace Day02a {
+
 constexpr Game::TShape cookShape(int a, int b, int c, int d, int e, int f) {
 	return Game::TShape{
 		{
@@ -47,7 +52,9 @@ constexpr Game::TShape cookLines(int n) {
 	return shape;
 }
 
-int main() {
+// Plays every round without printing: the board goes to std::wcout, which must not share
+// stdout with the narrow streams the driver writes to.
+Game play(std::string_view input) {
 	Game game(6, 45100);
 
 	static constexpr auto enemyLine = cookShape(1, 0, 0, 0, 0, 0);
@@ -65,13 +72,6 @@ int main() {
 	static constexpr auto twoImmediateLines = cookLines(2);
 	static constexpr auto threeImmediateLines = cookLines(3);
 
-	std::ifstream input;
-	input.open("input.txt");
-
-	std::string line;
-
-	int turn = 0;
-
 	int expected = 0;
 	
 	std::vector<std::vector<int>> table{
@@ -80,13 +80,23 @@ int main() {
 		{7, 2, 6}
 	};
 	
-	while(std::getline(input, line)) {
+	for(auto const line : aoc::splitLines(input)) {
+		[[unlikely]]
+		if(line.length() != 3) {
+			aoc::crash("Invalid input! (Line of length " + std::to_string(line.length()) + ")");
+		}
+
 		char const opponent = line[0];
 		char const me = line[2];
 
 		int oppI = opponent - 'A';
 		int meI = me - 'X';
 
+		[[unlikely]]
+		if(oppI < 0 || oppI >= int(table.size()) || meI < 0 || meI >= int(table.front().size())) {
+			aoc::crash("Invalid shapes " + std::string(line));
+		}
+
 		expected += table[oppI][meI];
 
 		switch(opponent) {
@@ -106,7 +116,7 @@ int main() {
 			game.DropShape(enemySquareWidth2);
 			break;
 		default:
-			exit(1);
+			aoc::crash("Invalid enemy shape " + std::string(1, opponent));
 		}
 
 		switch(me) {
@@ -129,19 +139,31 @@ int main() {
 			game.DropShape(threeImmediateLines);
 			break;
 		default:
-			exit(2);
+			aoc::crash("Invalid own shape " + std::string(1, me));
 		}
 
 
-		++turn;
-
 		assert(expected == game.GetScore());
-
-		std::wcout << "Turn " << turn << " Score: " << game.GetScore() << '\n';
 	}
+
+	return game;
+}
+
+aoc::Answers solve(std::string_view input) {
+	return { .Part1 = play(input).GetScore() };
+}
+
+}
+
+#ifndef AOC_DRIVER
+int main() {
+	aoc::PuzzleInput input("input.txt");
+
+	auto game = Day02a::play(input.Data());
 	game.PrintBoard();
 
 	std::wcout << "DONE!" << std::endl;
 
 	return 0;
-}
\ No newline at end of file
+}
+#endif
\ No newline at end of file
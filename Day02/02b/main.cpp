@@ -1,18 +1,16 @@
 #include <array>
-#include <fstream>
+#include <cstdio>
 #include <iostream>
 #include <string>
 
-int main() {
-	std::ifstream input("input.txt");
-	
-	if(!input.is_open()) {
-		std::cerr << "Could not open the input file.\n";
-		exit(1);
-	}
+#include "../../Common/crash.h"
+#include "../../Common/input.h"
+#include "../../Common/solver.h"
+#include "../../Common/stream.h"
 
-	std::string line{};
+namespace Day02b {
 
+aoc::Answers solveLines(aoc::LineReader& lines) {
 	std::array<std::array<int, 3>, 3> table = { 
 		{
 			{3, 4, 8},
@@ -23,11 +21,10 @@ int main() {
 
 	int score = 0;
 
-	while(std::getline(input, line)) {
+	for(std::string_view line; lines.Next(line);) {
 		[[unlikely]]
 		if(line.length() != 3) {
-			std::cerr << "Invalid input! (Line of length " << line.length() << '\n';
-			exit(2);
+			aoc::crash("Invalid input! (Line of length " + std::to_string(line.length()) + ")");
 		}
 
 		char const enemy = line.front();
@@ -38,21 +35,45 @@ int main() {
 
 		[[unlikely]]
 		if(enemyIdx < 0 || enemyIdx >= table.size()) {
-			std::cerr << "Invalid enemy index " << enemyIdx << '\n';
-			exit(3);
+			aoc::crash("Invalid enemy index " + std::to_string(enemyIdx));
 		}
 
 		[[unlikely]]
 		if(outcomeIdx < 0 || outcomeIdx >= table.front().size()) {
-			std::cerr << "Invalid outcome index " << outcomeIdx << '\n';
-			exit(4);
+			aoc::crash("Invalid outcome index " + std::to_string(outcomeIdx));
 		}
 
 		score += table[enemyIdx][outcomeIdx];
 	}
 
-	input.close();
+	return { .Part2 = score };
+}
+
+aoc::Answers solve(std::string_view input) {
+	aoc::LineReader lines(input);
+	return solveLines(lines);
+}
+
+aoc::Answers solveStream(std::FILE* stream) {
+	aoc::LineReader lines(stream);
+	return solveLines(lines);
+}
+
+}
+
+#ifndef AOC_DRIVER
+int main(int argc, char** argv) {
+	aoc::Answers answers;
+
+	if(aoc::isStreamRequested(argc, argv)) {
+		answers = Day02b::solveStream(stdin);
+	}
+	else {
+		aoc::PuzzleInput input("input.txt");
+		answers = Day02b::solve(input.Data());
+	}
 
-	std::cout << "Score: " << score << '\n';
+	std::cout << "Score: " << aoc::toString(answers.Part2) << '\n';
 
-}
\ No newline at end of file
+}
+#endif
\ No newline at end of file
@@ -1,13 +1,19 @@
-#include <fstream>
+#include <cstdio>
 #include <iostream>
 #include <string>
 #include <unordered_set>
 
+#include "../../Common/crash.h"
+#include "../../Common/input.h"
+#include "../../Common/solver.h"
+#include "../../Common/stream.h"
+
+namespace Day03a {
+
 int getPriority(char c) {
 
 	if(!std::isalpha(c)) {
-		std::cerr << "Given character is not a letter\n";
-		exit(2);
+		aoc::crash("Given character is not a letter");
 	}
 
 	int priority{ 0 };
@@ -20,20 +26,12 @@ int getPriority(char c) {
 		return int(c - 'A') + 27;
 	}
 	
-	std::cerr << "WTF cannot get priority ???\n";
-	exit(3);
+	aoc::crash("WTF cannot get priority ???");
 }
 
-int main() {
-	std::ifstream input("input.txt");
-
+aoc::Answers solveLines(aoc::LineReader& lines) {
 	std::unordered_set<char> backpack1, backpack2;
 
-	if(!input.is_open()) {
-		std::cerr << "Cannot open input file.\n";
-		return 1;
-	}
-
 	auto getCommonElement = [&backpack1, &backpack2]() -> char {
 		for(auto element : backpack1) {
 			if(backpack2.count(element)) {
@@ -41,15 +39,12 @@ int main() {
 			}
 		}
 
-		std::cerr << "The sets have no common element!";
-		exit(4);
+		aoc::crash("The sets have no common element!");
 	};
 
-	std::string line{};
-
 	int totalPriority{ 0 };
 
-	while(std::getline(input, line)) {
+	for(std::string_view line; lines.Next(line);) {
 		
 		int const lineHalfSize = int(line.length()) / 2;
 
@@ -69,7 +64,35 @@ int main() {
 
 	}
 
-	std::cout << "Sum of priorities: " << totalPriority << '\n';
+	return { .Part1 = totalPriority };
+}
+
+aoc::Answers solve(std::string_view input) {
+	aoc::LineReader lines(input);
+	return solveLines(lines);
+}
+
+aoc::Answers solveStream(std::FILE* stream) {
+	aoc::LineReader lines(stream);
+	return solveLines(lines);
+}
+
+}
+
+#ifndef AOC_DRIVER
+int main(int argc, char** argv) {
+	aoc::Answers answers;
+
+	if(aoc::isStreamRequested(argc, argv)) {
+		answers = Day03a::solveStream(stdin);
+	}
+	else {
+		aoc::PuzzleInput input("input.txt");
+		answers = Day03a::solve(input.Data());
+	}
+
+	std::cout << "Sum of priorities: " << aoc::toString(answers.Part1) << '\n';
 
 	return 0;
-}
\ No newline at end of file
+}
+#endif
\ No newline at end of file
@@ -1,13 +1,19 @@
-#include <fstream>
+#include <cstdio>
 #include <iostream>
 #include <string>
 #include <unordered_map>
 
+#include "../../Common/crash.h"
+#include "../../Common/input.h"
+#include "../../Common/solver.h"
+#include "../../Common/stream.h"
+
+namespace Day03b {
+
 int getPriority(char c) {
 
 	if(!std::isalpha(c)) {
-		std::cerr << "Given character is not a letter\n";
-		exit(2);
+		aoc::crash("Given character is not a letter");
 	}
 
 	int priority{ 0 };
@@ -20,27 +26,17 @@ int getPriority(char c) {
 		return int(c - 'A') + 27;
 	}
 	
-	std::cerr << "WTF cannot get priority ???\n";
-	exit(3);
+	aoc::crash("WTF cannot get priority ???");
 }
 
-int main() {
-	std::ifstream input("input.txt");
-
+aoc::Answers solveLines(aoc::LineReader& lines) {
 	std::unordered_map<char, int> backpackCount;
 
-	if(!input.is_open()) {
-		std::cerr << "Cannot open input file.\n";
-		return 1;
-	}
-
-	std::string line{};
-
 	int totalPriority{ 0 };
 
 	int lineIdx = 0;
 
-	while(std::getline(input, line)) {
+	for(std::string_view line; lines.Next(line);) {
 		++lineIdx;
 		
 		if(lineIdx == 1) {
@@ -80,7 +76,35 @@ int main() {
 
 	}
 
-	std::cout << "Sum of priorities: " << totalPriority << '\n';
+	return { .Part2 = totalPriority };
+}
+
+aoc::Answers solve(std::string_view input) {
+	aoc::LineReader lines(input);
+	return solveLines(lines);
+}
+
+aoc::Answers solveStream(std::FILE* stream) {
+	aoc::LineReader lines(stream);
+	return solveLines(lines);
+}
+
+}
+
+#ifndef AOC_DRIVER
+int main(int argc, char** argv) {
+	aoc::Answers answers;
+
+	if(aoc::isStreamRequested(argc, argv)) {
+		answers = Day03b::solveStream(stdin);
+	}
+	else {
+		aoc::PuzzleInput input("input.txt");
+		answers = Day03b::solve(input.Data());
+	}
+
+	std::cout << "Sum of priorities: " << aoc::toString(answers.Part2) << '\n';
 
 	return 0;
-}
\ No newline at end of file
+}
+#endif
\ No newline at end of file
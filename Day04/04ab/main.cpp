@@ -1,18 +1,20 @@
-#include <fstream>	
+#include <charconv>
+#include <cstdio>
 #include <format>
 #include <iostream>
 #include <ranges>
 #include <string>
 #include <tuple>
 
-int main() {
-	std::ifstream input("input.txt");
+#include "../../Common/crash.h"
+#include "../../Common/input.h"
+#include "../../Common/log.h"
+#include "../../Common/solver.h"
+#include "../../Common/stream.h"
 
-	if(!input.is_open()) {
-		std::cerr << "Could not open the input file.\n";
-		exit(1);
-	}
-	
+namespace Day04ab {
+
+aoc::Answers solveLines(aoc::LineReader& lines) {
 	auto isContainedIn = [](int outerLeft, int outerRight, int innerLeft, int innerRight) -> bool {
 		return outerLeft <= innerLeft && outerRight >= innerRight;
 	};
@@ -29,16 +31,16 @@ int main() {
 	int fullyContained{ 0 };
 	int overlaps{ 0 };
 
-	std::string line{};
-
-	while(std::getline(input, line)) {
+	for(std::string_view line; lines.Next(line);) {
 		
 		auto elfPair = line | std::views::split(',') | std::views::transform(
 			[](auto&& range) {
 			return range | std::views::split('-') | std::views::transform(
 				[](auto&& range) -> int {
-					char* end{};
-					return std::strtol(&*range.begin(), &end, 0);
+					// the line is a view into the input buffer now, so strtol would not stop at the line end
+					int value{};
+					std::from_chars(&*range.begin(), &*range.begin() + std::ranges::distance(range), value);
+					return value;
 				}
 			);
 		}
@@ -47,8 +49,7 @@ int main() {
 				int const size = int(std::distance(range.begin(), range.end()));
 
 				if(size != 2) {
-					std::cerr << "Expected pair, got size " << size << '\n';
-					exit(2);
+					aoc::crash("Expected pair, got size " + std::to_string(size));
 				}
 
 				return std::make_pair(*range.begin(), *std::next(range.begin()));
@@ -58,8 +59,7 @@ int main() {
 		int const elfSize = int(std::distance(elfPair.begin(), elfPair.end()));
 
 		if(elfSize != 2) {
-			std::cerr << "Expected elf pair, got size " << elfSize << '\n';
-			exit(3);
+			aoc::crash("Expected elf pair, got size " + std::to_string(elfSize));
 		}
 
 		auto const firstElf = *elfPair.begin(), secondElf = *std::next(elfPair.begin());
@@ -69,22 +69,48 @@ int main() {
 
 		if(isEitherContainedIn(firstElfStart, firstElfEnd, secondElfStart, secondElfEnd)) {
 			++fullyContained;
-			std::cout << '!';
+			AOC_TRACE('!');
 		}
 
 		if(isIntervalOverlap(firstElfStart, firstElfEnd, secondElfStart, secondElfEnd)) {
 			++overlaps;
-			std::cout << '*';
+			AOC_TRACE('*');
 		}
 		
-		std::cout << std::format("{}-{},{}-{}\n", firstElfStart, firstElfEnd, secondElfStart, secondElfEnd);
+		AOC_TRACE(std::format("{}-{},{}-{}\n", firstElfStart, firstElfEnd, secondElfStart, secondElfEnd));
 
 	}
 
-	input.close();
+	return { .Part1 = fullyContained, .Part2 = overlaps };
+}
+
+aoc::Answers solve(std::string_view input) {
+	aoc::LineReader lines(input);
+	return solveLines(lines);
+}
+
+aoc::Answers solveStream(std::FILE* stream) {
+	aoc::LineReader lines(stream);
+	return solveLines(lines);
+}
+
+}
+
+#ifndef AOC_DRIVER
+int main(int argc, char** argv) {
+	aoc::Answers answers;
+
+	if(aoc::isStreamRequested(argc, argv)) {
+		answers = Day04ab::solveStream(stdin);
+	}
+	else {
+		aoc::PuzzleInput input("input.txt");
+		answers = Day04ab::solve(input.Data());
+	}
 
-	std::cout << "Fully contained elf pairs: " << fullyContained << '\n';
-	std::cout << "Overlaps: " << overlaps << std::endl;
+	std::cout << "Fully contained elf pairs: " << aoc::toString(answers.Part1) << '\n';
+	std::cout << "Overlaps: " << aoc::toString(answers.Part2) << std::endl;
 
 	return 0;
-}
\ No newline at end of file
+}
+#endif
\ No newline at end of file
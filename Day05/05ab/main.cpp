@@ -1,39 +1,31 @@
-#include <charconv>
-#include <fstream>
+#include <cstdio>
 #include <iostream>
 #include <stack>
 #include <string>
 #include <vector>
 #include <ranges>
 
-int strToInt(std::string const& str) {
-	int result{};
+#include "../../Common/crash.h"
+#include "../../Common/input.h"
+#include "../../Common/numbers.h"
+#include "../../Common/solver.h"
+#include "../../Common/stream.h"
 
-	[[likely]]
-	if(std::from_chars(str.data(), str.data() + str.length(), result).ec == std::errc{}) {
-		return result;
-	}
-
-	std::cerr << "Could not convert string " << str << " to int.\n";
-	exit(3);
-}
-
-int main() {
-	std::fstream input("input.txt");
-
-	if(!input.is_open()) {
-		std::cerr << "Could not open the input file\n";
-		exit(1);
-	}
-
-	std::string line{};
+namespace Day05ab {
 
+// The drawing of the stacks is small and copied, the moves after it are handled one line at a time.
+aoc::Answers solveLines(aoc::LineReader& lines) {
 	std::vector<std::string> stackLines{};
 
-	while(std::getline(input, line) && line.length() > 0) {
+	for(std::string_view line; lines.Next(line) && !line.empty();) {
 		stackLines.emplace_back(line);
 	}
 
+	[[unlikely]]
+	if(stackLines.empty()) {
+		aoc::crash("The drawing of the stacks is missing");
+	}
+
 	int const n = ((int(stackLines.back().size()) - 3) / 4) + 1;
 
 	stackLines.pop_back();
@@ -44,6 +36,10 @@ int main() {
 		for(int i = 0; i < n; ++i) {
 			int const lineIdx = (4 * i) + 1;
 
+			if(lineIdx >= int(it->size())) {
+				break;
+			}
+
 			auto const crate = (*it)[lineIdx];
 
 			if(crate == ' ') {
@@ -56,27 +52,27 @@ int main() {
 
 	auto crateStacks2 = crateStacks;
 
-	while(std::getline(input, line)) {
+	for(std::string_view line; lines.Next(line);) {
 		
 		auto tokens = line | std::views::split(' ');
 
 		[[unlikely]]
 		if(std::distance(tokens.begin(), tokens.end()) != 6) {
-			std::cerr << "Could not parse 6 tokens, got " << std::distance(tokens.begin(), tokens.end()) << '\n';
-			exit(2);
+			aoc::crash("Could not parse 6 tokens, got " + std::to_string(std::distance(tokens.begin(), tokens.end())));
 		}
 
 		auto countIt = *std::next(tokens.begin(), 1);
 		auto sourceIt = *std::next(tokens.begin(), 3);
 		auto targetIt = *std::next(tokens.begin(), 5);
 	
-		std::string const countStr(countIt.begin(), countIt.end());
-		std::string const sourceStr(sourceIt.begin(), sourceIt.end());
-		std::string const targetStr(targetIt.begin(), targetIt.end());
+		auto const count = aoc::parseInt(std::string_view(countIt.begin(), countIt.end()));
+		auto const source = aoc::parseInt(std::string_view(sourceIt.begin(), sourceIt.end()));
+		auto const target = aoc::parseInt(std::string_view(targetIt.begin(), targetIt.end()));
 
-		auto const count = strToInt(countStr);
-		auto const source = strToInt(sourceStr);
-		auto const target = strToInt(targetStr);
+		[[unlikely]]
+		if(source < 1 || source > n || target < 1 || target > n || count < 0 || count > int(crateStacks[source - 1].size())) {
+			aoc::crash("Cannot move " + std::to_string(count) + " crates from stack " + std::to_string(source) + " to stack " + std::to_string(target));
+		}
 
 		auto& sourceStack = crateStacks[source - 1];
 		auto& targetStack = crateStacks[target - 1];
@@ -98,18 +94,54 @@ int main() {
 		sourceStack2.erase(sourceStartIt, sourceStack2.end());
 	}
 
+	std::string topCrates, topCrates2;
+
 	for(auto const& crates : crateStacks) {
-		std::cout << crates.back();
-	}
+		[[unlikely]]
+		if(crates.empty()) {
+			aoc::crash("A stack ends up empty");
+		}
 
-	std::cout << std::endl;
+		topCrates.push_back(crates.back());
+	}
 
 	for(auto const& crates : crateStacks2) {
-		std::cout << crates.back();
+		topCrates2.push_back(crates.back());
+	}
+
+	return { .Part1 = std::move(topCrates), .Part2 = std::move(topCrates2) };
+
+}
+
+aoc::Answers solve(std::string_view input) {
+	aoc::LineReader lines(input);
+	return solveLines(lines);
+}
+
+aoc::Answers solveStream(std::FILE* stream) {
+	aoc::LineReader lines(stream);
+	return solveLines(lines);
+}
+
+}
+
+#ifndef AOC_DRIVER
+int main(int argc, char** argv) {
+	aoc::Answers answers;
+
+	if(aoc::isStreamRequested(argc, argv)) {
+		answers = Day05ab::solveStream(stdin);
+	}
+	else {
+		aoc::PuzzleInput input("input.txt");
+		answers = Day05ab::solve(input.Data());
 	}
 
-	std::cout << std::endl;
+	std::cout << aoc::toString(answers.Part1) << std::endl;
+
+	std::cout << aoc::toString(answers.Part2) << std::endl;
 
 	return 0;
 
-}
\ No newline at end of file
+}
+#endif
\ No newline at end of file
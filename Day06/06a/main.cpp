@@ -1,43 +1,132 @@
-#include <fstream>
+#include <algorithm>
+#include <cstdio>
 #include <iostream>
 #include <string>
 #include <unordered_map>
 
-int main() {
-	std::fstream input("input.txt");
+#include "../../Common/crash.h"
+#include "../../Common/input.h"
+#include "../../Common/log.h"
+#include "../../Common/solver.h"
+#include "../../Common/stream.h"
 
-	[[unlikely]]
-	if(!input.is_open()) {
-		std::cerr << "Could not open input file.\n";
-		exit(1);
+namespace Day06a {
+
+// Remembers where each character was seen last, so the signal can also arrive in pieces.
+class MarkerFinder {
+public:
+	// True as soon as the last 4 characters were all different.
+	bool Consume(std::string_view signal) {
+		for(auto const c : signal) {
+			auto& timeStamp = TimeStamps[c];
+
+			BlockUntil = std::max(BlockUntil, timeStamp + 4);
+
+			AOC_TRACE("blockUntil = " << BlockUntil << '\n');
+
+			timeStamp = Position;
+
+			if(Position >= BlockUntil) {
+				return true;
+			}
+
+			++Position;
+		}
+
+		return false;
+	}
+
+	long long GetMarkerEnd() const {
+		return Position + 1;
 	}
 
-	std::string signal{};
+private:
+	std::unordered_map<char, long long> TimeStamps{};
+	long long BlockUntil = 4;
+	long long Position = 0;
+};
+
+[[noreturn]]
+void failToReadSignal() {
+	aoc::crash("Could not read the signal");
+}
+
+aoc::Answers solve(std::string_view input) {
+	aoc::LineReader lines(input);
+
+	std::string_view signal;
 
 	[[unlikely]]
-	if(!std::getline(input, signal)) {
-		std::cerr << "Could not read the signal\n";
-		exit(2);
+	if(!lines.Next(signal)) {
+		failToReadSignal();
+	}
+
+	MarkerFinder finder;
+
+	if(finder.Consume(signal)) {
+		return { .Part1 = finder.GetMarkerEnd() };
 	}
 
-	std::unordered_map<char, int> timeStamps{};
+	return {};
+}
+
+// The signal is a single line, so it is read in chunks instead of lines to keep memory bounded.
+aoc::Answers solveStream(std::FILE* stream) {
+	aoc::ChunkReader chunks(stream);
+
+	MarkerFinder finder;
+	bool isEmpty = true;
+	// a '\r' ending a chunk may be the first half of a CRLF split across chunks, so it only counts as part
+	// of the signal once the next chunk does not start with the '\n'
+	bool isCarriageReturnHeld = false;
+
+	for(std::string_view chunk; chunks.Next(chunk);) {
+		isEmpty = false;
 
-	int blockUntil = 4;
+		auto const lineEnd = chunk.find('\n');
+		auto signal = chunk.substr(0, lineEnd);
 
-	for(int i = 0; i < signal.size(); ++i) {
-		auto& timeStamp = timeStamps[signal[i]];
-		
-		blockUntil = std::max(blockUntil, timeStamp + 4);
+		if(isCarriageReturnHeld && lineEnd != 0 && finder.Consume("\r")) {
+			return { .Part1 = finder.GetMarkerEnd() };
+		}
+
+		isCarriageReturnHeld = false;
 
-		std::cout << "blockUntil = " << blockUntil << '\n';
+		if(signal.ends_with('\r')) {
+			isCarriageReturnHeld = lineEnd == std::string_view::npos;
+			signal.remove_suffix(1);
+		}
 
-		timeStamp = i;
+		if(finder.Consume(signal)) {
+			return { .Part1 = finder.GetMarkerEnd() };
+		}
 
-		if(i >= blockUntil) {
-			std::cout << "Solution 1: " << (i + 1) << std::endl;
+		if(lineEnd != std::string_view::npos) {
 			break;
 		}
 	}
 
-	input.close();
-}
\ No newline at end of file
+	[[unlikely]]
+	if(isEmpty) {
+		failToReadSignal();
+	}
+
+	return {};
+}
+}
+
+#ifndef AOC_DRIVER
+int main(int argc, char** argv) {
+	aoc::Answers answers;
+
+	if(aoc::isStreamRequested(argc, argv)) {
+		answers = Day06a::solveStream(stdin);
+	}
+	else {
+		aoc::PuzzleInput input("input.txt");
+		answers = Day06a::solve(input.Data());
+	}
+
+	std::cout << "Solution 1: " << aoc::toString(answers.Part1) << std::endl;
+}
+#endif
\ No newline at end of file
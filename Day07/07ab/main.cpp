@@ -1,11 +1,19 @@
-#include <charconv>
-#include <fstream>
+#include <cstdio>
 #include <iostream>
 #include <ranges>
 #include <string>
 #include <variant>
 #include <unordered_map>
 
+#include "../../Common/crash.h"
+#include "../../Common/input.h"
+#include "../../Common/log.h"
+#include "../../Common/numbers.h"
+#include "../../Common/solver.h"
+#include "../../Common/stream.h"
+
+namespace Day07ab {
+
 class File {
 public:
 	File() noexcept = default;
@@ -64,27 +72,10 @@ private:
 	Directory* Parent{};
 };
 
-long long strToInt(std::string const& str) {
-	long long result{};
-
-	[[likely]]
-	if(std::from_chars(str.data(), str.data() + str.length(), result).ec == std::errc{}) {
-		return result;
-	}
-
-	std::cerr << "Could not convert string " << str << " to int.\n";
-	exit(3);
-}
-
-
-int main() {
+aoc::Answers solveLines(aoc::LineReader& lines) {
 
 	Directory root("/");
 
-	std::fstream input("input.txt");
-
-	std::string line{};
-
 	Directory* currentDirectory = &root;
 
 	auto performCd = [&currentDirectory, &root](std::string const& targetDirectory) mutable -> void {
@@ -96,8 +87,7 @@ int main() {
 
 			[[unlikely]]
 			if(!parentDirectory) {
-				std::cerr << "Parent directory does not exist!\n";
-				exit(2);
+				aoc::crash("Parent directory does not exist!");
 			}
 
 			currentDirectory = parentDirectory;
@@ -110,8 +100,7 @@ int main() {
 					return std::get<Directory>(entry);
 				}
 				catch(std::bad_variant_access const& ex) {
-					std::cerr << "Entry is not a directory\n" << ex.what() << std::endl;
-					exit(3);
+					aoc::crash("Entry is not a directory\n" + std::string(ex.what()));
 				}
 			}();
 
@@ -155,15 +144,15 @@ int main() {
 			currentDirectory->AddEntry(Directory(arg1, currentDirectory));
 		}
 		else {
-			long long const size = strToInt(arg0);
+			long long const size = aoc::parseInt<long long>(arg0);
 
 			currentDirectory->AddEntry(File(arg1, size));
 		}
 	};
 
-	while(std::getline(input, line)) {
+	for(std::string_view line; lines.Next(line);) {
 
-		std::cout << line << '\n';
+		AOC_TRACE(line << '\n');
 		
 		auto split = std::views::split(line, ' ');
 
@@ -171,8 +160,7 @@ int main() {
 
 		[[unlikely]]
 		if(argCount < 2) {
-			std::cerr << "Not enough arguments! (" << argCount << ")\n";
-			exit(1);
+			aoc::crash("Not enough arguments! (" + std::to_string(argCount) + ")");
 		}
 
 		auto arg0it = *split.begin();
@@ -187,8 +175,7 @@ int main() {
 				
 				[[unlikely]]
 				if(argCount < 3) {
-					std::cerr << "Not enough arguments! (" << argCount << ")\n";
-					exit(1);
+					aoc::crash("Not enough arguments! (" + std::to_string(argCount) + ")");
 				}
 
 				
@@ -231,11 +218,11 @@ int main() {
 
 	long long smallestSufficientFolderSize = usedSpace;
 
-	std::cout << '\n';
+	AOC_DEBUG('\n');
 
 	for(auto const& [directoryPath, directorySize] : directorySizes) {
 
-		std::cout << '[' << directoryPath << ',' << directorySize << "]\n";
+		AOC_DEBUG('[' << directoryPath << ',' << directorySize << "]\n");
 		
 		if(directorySize <= 100000) {
 			satisfactoryDirectoriesSize += directorySize;
@@ -247,8 +234,35 @@ int main() {
 
 	}
 
-	std::cout << "Size of satiscaftory directories: " << satisfactoryDirectoriesSize << '\n';
-	std::cout << "Smallest sufficient folder to delete: " << smallestSufficientFolderSize << '\n';
+	return { .Part1 = satisfactoryDirectoriesSize, .Part2 = smallestSufficientFolderSize };
+}
+
+aoc::Answers solve(std::string_view input) {
+	aoc::LineReader lines(input);
+	return solveLines(lines);
+}
+
+aoc::Answers solveStream(std::FILE* stream) {
+	return aoc::solvePrefetchedLines(stream, solveLines);
+}
+
+}
+
+#ifndef AOC_DRIVER
+int main(int argc, char** argv) {
+	aoc::Answers answers;
+
+	if(aoc::isStreamRequested(argc, argv)) {
+		answers = Day07ab::solveStream(stdin);
+	}
+	else {
+		aoc::PuzzleInput input("input.txt");
+		answers = Day07ab::solve(input.Data());
+	}
+
+	std::cout << "Size of satiscaftory directories: " << aoc::toString(answers.Part1) << '\n';
+	std::cout << "Smallest sufficient folder to delete: " << aoc::toString(answers.Part2) << '\n';
 
 	return 0;
-}
\ No newline at end of file
+}
+#endif
\ No newline at end of file
@@ -1,110 +1,115 @@
+#include <algorithm>
 #include <array>
-#include <cassert>
-#include <fstream>
+#include <cstddef>
 #include <iostream>
-#include <stack>
 #include <string>
-#include <tuple>
 #include <vector>
 
-void crash(std::string const& message) {
-	std::cerr << message << std::endl;
-	assert(false);
-	exit(1);
-}
+#include "../../Common/crash.h"
+#include "../../Common/grid.h"
+#include "../../Common/input.h"
+#include "../../Common/log.h"
+#include "../../Common/solver.h"
+
+namespace Day08ab {
 
-void markVisibleTreesInLine(std::vector<std::vector<int>> const& trees, std::vector<std::vector<bool>>& visibility, int beginX, int beginY, int endX, int endY, int deltaX, int deltaY) {
+// Marks every tree taller than all trees before it in the line, looking from either end. The line is a
+// row or a column of the grid; mark gets the position along it.
+template<typename Line, typename Mark>
+void markVisibleTreesInLine(Line const& trees, Mark&& mark) {
 
 	int previous = -1;
 
-	for(int x = beginX, y = beginY; x != endX && y != endY; x += deltaX, y += deltaY) {
+	for(std::size_t i = 0; i < trees.size(); ++i) {
 		
-		if(trees[y][x] > previous) {
-			previous = trees[y][x];
-			visibility[y][x] = true;
+		if(trees[i] > previous) {
+			previous = trees[i];
+			mark(int(i));
 		}
 	}
-}
 
-int lookAround(std::vector<std::vector<int>> const& trees, int x, int y) {
+	previous = -1;
 
-	std::stack<std::tuple<std::pair<int, int>, std::pair<int, int>, int>> ss;
+	for(std::size_t i = trees.size(); i-- > 0;) {
 
-	std::array<int, 4> pathLengths{};
+		if(trees[i] > previous) {
+			previous = trees[i];
+			mark(int(i));
+		}
+	}
+}
 
-	ss.push({ {x + 1, y}, {1, 0} , 0});
-	ss.push({ {x - 1, y}, {-1, 0} , 1});
-	ss.push({ {x, y + 1}, {0, 1} , 2});
-	ss.push({ {x, y - 1}, {0, -1} , 3});
+static constexpr std::array<std::array<int, 2>, 4> directions{ {
+	{1, 0},
+	{-1, 0},
+	{0, 1},
+	{0, -1}
+} };
 
-	int const query = trees[y][x];
+// The grid is padded with -1, so every walk ends at the border without a bounds check.
+int lookAround(aoc::Grid2D<int> const& trees, int x, int y) {
 
-	while(!ss.empty()) {
-		auto const [coords, direction, key] = ss.top();
-		auto const [xx, yy] = coords;
-		auto const [dx, dy] = direction;
-		ss.pop();
+	int const query = trees(x, y);
 
-		if(xx < 0 || yy < 0 || xx >= trees.front().size() || yy >= trees.size()) {
-			continue;
-		}
-		
-		++pathLengths[key];
+	int scenicScore = 1;
 
-		if(trees[yy][xx] < query) {
-			ss.push({ { xx + dx, yy + dy }, direction , key});
-		}
+	for(auto const& [dx, dy] : directions) {
+		int pathLength = 0;
 
-	}
+		for(int xx = x + dx, yy = y + dy; trees(xx, yy) >= 0; xx += dx, yy += dy) {
+			++pathLength;
 
-	int scenicScore = 1;
+			if(trees(xx, yy) >= query) {
+				break;
+			}
+		}
 
-	for(auto const directionalScore : pathLengths) {
-		scenicScore *= directionalScore;
+		scenicScore *= pathLength;
 	}
 
 	return scenicScore;
 }
 
-int main() {
-	
-	std::fstream input("input.txt");
+aoc::Answers solve(std::string_view input) {
+
+	auto const lines = aoc::splitLines(input);
 
 	[[unlikely]]
-	if(!input.is_open()) {
-		crash("Could not open input file");
+	if(lines.empty()) {
+		aoc::crash("The map is empty");
 	}
 
-	std::string line{};
+	int const endY = int(lines.size());
+	int const endX = int(lines.front().size());
 
-	std::vector<std::vector<int>> trees;
+	aoc::Grid2D<int> trees(endX, endY, 0, 1, -1);
 
-	while(std::getline(input, line)) {
-		std::vector<int> treeLine;
-		treeLine.reserve(line.length());
-
-		for(auto const& c : line) {			
-			treeLine.emplace_back(int(c - '0'));
+	for(int y = 0; y < endY; ++y) {
+		[[unlikely]]
+		if(int(lines[y].size()) != endX) {
+			aoc::crash("Line " + std::to_string(y + 1) + " is not as wide as the first");
 		}
 
-		trees.emplace_back(std::move(treeLine));
-	}
+		for(int x = 0; x < endX; ++x) {
+			[[unlikely]]
+			if(lines[y][x] < '0' || lines[y][x] > '9') {
+				aoc::crash("Invalid tree height " + std::string(1, lines[y][x]));
+			}
 
-	input.close();
+			trees(x, y) = int(lines[y][x] - '0');
+		}
+	}
 
-	std::vector<std::vector<bool>> visibleTrees{trees.size(), std::vector<bool>(trees.front().size())};
+	aoc::markParsed();
 
-	int const endY = int(trees.size());
-	int const endX = int(trees.front().size());
+	aoc::Grid2D<bool> visibleTrees(endX, endY);
 
 	for(int y = 0; y < endY; ++y) {
-		markVisibleTreesInLine(trees, visibleTrees, 0, y, endX, y + 1, 1, 0);
-		markVisibleTreesInLine(trees, visibleTrees, endX - 1, y, -1, y + 1, -1, 0);
+		markVisibleTreesInLine(trees.Row(y), [&visibleTrees, y](int x) { visibleTrees(x, y) = true; });
 	}
 
 	for(int x = 0; x < endX; ++x) {
-		markVisibleTreesInLine(trees, visibleTrees, x, 0, x + 1, endY, 0, 1);
-		markVisibleTreesInLine(trees, visibleTrees, x, endY - 1, x + 1, -1, 0, -1);
+		markVisibleTreesInLine(trees.Column(x), [&visibleTrees, x](int y) { visibleTrees(x, y) = true; });
 	}
 
 	int visibleTreesCount = 0;
@@ -113,7 +118,7 @@ int main() {
 	for(int y = 0; y < endY; ++y) {
 		for(int x = 0; x < endX; ++x) {
 
-			if(visibleTrees[y][x]) {
+			if(visibleTrees(x, y)) {
 				++visibleTreesCount;
 			}
 
@@ -121,13 +126,25 @@ int main() {
 
 			bestScenicScore = std::max(bestScenicScore, scenicScore);
 
-			std::cout << scenicScore;
+			AOC_TRACE(scenicScore);
 		}
-		std::cout << '\n';
+		AOC_TRACE('\n');
 	}
 
-	std::cout << "Visible trees: " << visibleTreesCount << '\n';
-	std::cout << "Best scenic score: " << bestScenicScore << '\n';
+	return { .Part1 = visibleTreesCount, .Part2 = bestScenicScore };
+}
+
+}
+
+#ifndef AOC_DRIVER
+int main() {
+	aoc::PuzzleInput input("input.txt");
+
+	auto const answers = Day08ab::solve(input.Data());
+
+	std::cout << "Visible trees: " << aoc::toString(answers.Part1) << '\n';
+	std::cout << "Best scenic score: " << aoc::toString(answers.Part2) << '\n';
 
 	return 0;
-}
\ No newline at end of file
+}
+#endif
\ No newline at end of file
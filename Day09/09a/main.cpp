@@ -1,16 +1,18 @@
-#include <cassert>
-#include <charconv>
-#include <fstream>
+#include <cstdio>
 #include <iostream>
 #include <string>
 #include <tuple>
-#include <unordered_set>
 
-void crash(std::string const& message) {
-	std::cerr << message << '\n';
-	assert(false);
-	exit(1);
-}
+#include "../../Common/crash.h"
+#include "../../Common/hashmap.h"
+#include "../../Common/input.h"
+#include "../../Common/numbers.h"
+#include "../../Common/solver.h"
+#include "../../Common/stream.h"
+
+namespace Day09a {
+
+using aoc::crash;
 
 std::pair<int, int> parseDirection(char direction) {
 	switch(direction) {
@@ -23,25 +25,12 @@ std::pair<int, int> parseDirection(char direction) {
 	case 'R':
 		return { 1, 0 };
 	default:
-		crash("Invalid direction " + direction);
+		crash("Invalid direction " + std::string(1, direction));
 	}
 
 	return {};
 }
 
-int parseInt(std::string_view str) {
-	
-	int value{};
-
-	[[likely]]
-	if(std::from_chars(str.data(), str.data() + str.length(), value).ec == std::errc{}) {
-		return value;
-	}
-
-	crash("Could not parse int " + std::string(str.begin(), str.end()));
-	return 0;
-}
-
 int getDirection(int from, int to) {
 	if(from == to) {
 		return 0;
@@ -60,38 +49,22 @@ struct Coords {
 	bool operator==(Coords const& other) const = default;
 };
 
-template<>
-struct std::hash<Coords> {	
-	std::size_t operator()(Coords const& coords) const noexcept {
-		return std::hash<int>{}(coords.x) ^ std::hash<int>{}(coords.y);
-	}
-};
-
-int main() {
-	
-	std::fstream input("input.txt");
-
-	[[unlikely]]
-	if(!input.is_open()) {
-		crash("Could not open the input file.");
-	}
+aoc::Answers solveLines(aoc::LineReader& lines) {
 
 	Coords head{}, tail{};
 
-	std::string line{};
+	aoc::FlatSet<Coords> tailVisitedCoords{};
+	tailVisitedCoords.Insert(tail);
 
-	std::unordered_set<Coords> tailVisitedCoords{};
-	tailVisitedCoords.insert(tail);
-
-	while(std::getline(input, line)) {
+	for(std::string_view line; lines.Next(line);) {
 		[[unlikely]]
 		if(line.length() < 3) {
-			crash("Could not parse line " + line);
+			crash("Could not parse line " + std::string(line));
 		}
 
 		auto const [dx, dy] = parseDirection(line[0]);
 
-		int nSteps = parseInt(std::string_view(std::next(line.begin(), 2), line.end()));
+		int nSteps = aoc::parseInt(std::string_view(std::next(line.begin(), 2), line.end()));
 
 		for(int step = 0; step < nSteps; ++step) {
 			
@@ -106,16 +79,43 @@ int main() {
 				tail.x += tailDx;
 				tail.y += tailDy;
 			
-				tailVisitedCoords.insert(tail);
+				tailVisitedCoords.Insert(tail);
 
 			}
 		}
 	}
 
-	input.close();
+	return { .Part1 = (long long)(tailVisitedCoords.GetSize()) };
+
+}
+
+aoc::Answers solve(std::string_view input) {
+	aoc::LineReader lines(input);
+	return solveLines(lines);
+}
+
+aoc::Answers solveStream(std::FILE* stream) {
+	aoc::LineReader lines(stream);
+	return solveLines(lines);
+}
+
+}
 
-	std::cout << "Tail visited coords size: " << tailVisitedCoords.size() << '\n';
+#ifndef AOC_DRIVER
+int main(int argc, char** argv) {
+	aoc::Answers answers;
+
+	if(aoc::isStreamRequested(argc, argv)) {
+		answers = Day09a::solveStream(stdin);
+	}
+	else {
+		aoc::PuzzleInput input("input.txt");
+		answers = Day09a::solve(input.Data());
+	}
+
+	std::cout << "Tail visited coords size: " << aoc::toString(answers.Part1) << '\n';
 
 	return 0;
 
-}
\ No newline at end of file
+}
+#endif
\ No newline at end of file
@@ -1,140 +1,163 @@
-#include <cassert>
-#include <charconv>
-#include <fstream>
+#include <cstdio>
 #include <iostream>
 #include <queue>
 #include <string>
-#include <vector>
 
-void crash(std::string const& message) {
-	std::cout << message << '\n';
-	assert(false);
-	exit(1);
-}
-
-int strToInt(std::string_view str) {
-	int result{};
+#include "../../Common/crash.h"
+#include "../../Common/input.h"
+#include "../../Common/log.h"
+#include "../../Common/numbers.h"
+#include "../../Common/solver.h"
+#include "../../Common/stream.h"
 
-	[[likely]]
-	if(std::from_chars(str.data(), str.data() + str.length(), result).ec == std::errc{}) {
-		return result;
-	}
+namespace Day10ab {
 
-	crash("Could not parse int " + std::string(str.begin(), str.end()));
+// Part of the result cache keys, see aoc::Solver::Version.
+constexpr int solverVersion = 2;
 
-	return 0;
-}
+using aoc::crash;
 
+// Only the signal strength and the latest register value are kept instead of the whole history, so a
+// streamed program of any length runs in constant memory.
 class CPUsim {
 
 public:
 	void AddInstructionDelayed(int steps, int value = 0) {
 
 		for(int i = 0; i < steps; ++i) {
-			RegisterXhistory.emplace_back(RegisterX);
+			Record(RegisterX);
 		}
 
 		RegisterX += value;
-		Cycle += steps;
 	}
 
 	void AddInstruction(int steps, int value = 0) {
 
 		for(int i = 0; i < steps - 1; ++i) {
-			RegisterXhistory.emplace_back(RegisterX);
+			Record(RegisterX);
 		}
 
 		RegisterX += value;
-		Cycle += steps;
-		RegisterXhistory.emplace_back(RegisterX);
-	}
-
-	int GetRegisterValueAt(int cycle) {
-		return RegisterXhistory[cycle];
+		Record(RegisterX);
 	}
 
-	int GetCurrentCycle() const {
-		return Cycle;
+	// sum of (cycle + 1) * X over the cycles 19, 59, 99, ...
+	long long GetSignalStrength() const {
+		return SignalStrength;
 	}
 
 	int GetLastRegisterValue() const {
-		return RegisterXhistory.empty() ? 1 : RegisterXhistory.back();
+		return LastRegisterValue;
 	}
 
 private:
+	void Record(int registerValue) {
+		if(Cycle % 40 == 19) {
+			SignalStrength += (long long)(Cycle + 1) * registerValue;
+		}
+
+		LastRegisterValue = registerValue;
+		++Cycle;
+	}
 
 	int RegisterX{ 1 };
-	int Cycle{ 0 };
-	std::vector<int> RegisterXhistory{};
+	long long Cycle{ 0 };
+	long long SignalStrength{ 0 };
+	int LastRegisterValue{ 1 };
 };
 
-int main() {
+aoc::Answers solveLines(aoc::LineReader& lines) {
 
 	int const screenWidth = 40;
 	int const screenHeight = 6;
 
-	std::ifstream input("input.txt");
-
-	[[unlikely]]
-	if(!input.is_open()) {
-		crash("Could not open input file.");
-	}
-
 	CPUsim cpu1{}, cpu2{};
 
 	std::string screen{};
+	long long pixelCount = 0;
 
-	auto drawPixels = [&screen, &cpu2, screenWidth]() mutable -> void {
-		int const screenIdx = int(screen.size());
+	// pixels past the last row are still counted for the column but not kept
+	auto drawPixels = [&screen, &pixelCount, &cpu2, screenWidth, screenHeight]() mutable -> void {
+		long long const screenIdx = pixelCount++;
 		int const registerValue = cpu2.GetLastRegisterValue();
 
-		char const pixel = std::abs((screenIdx % screenWidth)- registerValue) <= 1 ? '#' : '.';
+		char const pixel = std::abs(int(screenIdx % screenWidth) - registerValue) <= 1 ? '#' : '.';
 
-		std::cout << "S " << screenIdx << " R " << registerValue << " -> " << pixel << '\n';
+		AOC_TRACE("S " << screenIdx << " R " << registerValue << " -> " << pixel << '\n');
 
-		screen.push_back(pixel);
+		if(screen.size() < std::size_t(screenWidth * screenHeight)) {
+			screen.push_back(pixel);
+		}
 	};
 
-	std::string line{};
-
-	while(std::getline(input, line)) {
+	for(std::string_view line; lines.Next(line);) {
 		drawPixels();
 		
 		if(line == "noop") {
-			std::cout << "NOOP\n";
+			AOC_TRACE("NOOP\n");
 			cpu1.AddInstructionDelayed(1);
 			cpu2.AddInstruction(1);
 		}
 		else { // !(line == "noop")
-			if(line.starts_with("addx")) {
-				std::cout << "ADDX\n";
-				int const value = strToInt(std::string_view(std::next(line.begin(), 5), line.end()));
+			if(line.starts_with("addx ")) {
+				AOC_TRACE("ADDX\n");
+				int const value = aoc::parseInt(std::string_view(std::next(line.begin(), 5), line.end()));
 				drawPixels();
 				cpu1.AddInstructionDelayed(2, value);
 				cpu2.AddInstruction(2, value);
 			}
 			else { // !(line.starts_with("addx")) && (line == "noop")
-				crash("Could not parse instruction line " + line);
+				crash("Could not parse instruction line " + std::string(line));
 			}
 		}
 
 	}
 
-	input.close();
+	long long const result = cpu1.GetSignalStrength();
 
-	int result = 0;
+	AOC_DEBUG("Signal strength " << result << '\n');
 
-	for(int i = 19; i < cpu1.GetCurrentCycle(); i += 40) {
-		auto const registerValue = cpu1.GetRegisterValueAt(i);
-		std::cout << i << " | " << registerValue << '\n';
-		result += (i + 1) * cpu1.GetRegisterValueAt(i);
-	}
+	// a program shorter than the screen leaves the rest of it dark
+	screen.resize(std::size_t(screenWidth * screenHeight), '.');
 
-	std::cout << "Result: " << result << std::endl;
+	std::string screenRows{};
 
 	for(int y = 0; y < screenHeight; ++y) {
-		std::cout << std::string_view(std::next(screen.begin(), y * screenWidth), std::next(screen.begin(), (y + 1) * screenWidth)) << '\n';
+		screenRows += std::string_view(std::next(screen.begin(), y * screenWidth), std::next(screen.begin(), (y + 1) * screenWidth));
+		screenRows += '\n';
 	}
 
+	return { .Part1 = result, .Part2 = std::move(screenRows) };
+}
+
+aoc::Answers solve(std::string_view input) {
+	aoc::LineReader lines(input);
+	return solveLines(lines);
+}
+
+aoc::Answers solveStream(std::FILE* stream) {
+	aoc::LineReader lines(stream);
+	return solveLines(lines);
+}
+
+}
+
+#ifndef AOC_DRIVER
+int main(int argc, char** argv) {
+	aoc::Answers answers;
+
+	if(aoc::isStreamRequested(argc, argv)) {
+		answers = Day10ab::solveStream(stdin);
+	}
+	else {
+		aoc::PuzzleInput input("input.txt");
+		answers = Day10ab::solve(input.Data());
+	}
+
+	std::cout << "Result: " << aoc::toString(answers.Part1) << std::endl;
+
+	std::cout << aoc::toString(answers.Part2);
+
 	return 0;
-}
\ No newline at end of file
+}
+#endif
\ No newline at end of file
@@ -1,18 +1,30 @@
 #include <algorithm>
-#include <cassert>
-#include <charconv>
-#include <fstream>
+#include <array>
 #include <functional>
 #include <iostream>
 #include <ranges>
 #include <stack>
 #include <string>
+#include <string_view>
 #include <vector>
 
+#include "../../Common/crash.h"
+#include "../../Common/input.h"
+#include "../../Common/log.h"
+#include "../../Common/numbers.h"
+#include "../../Common/solver.h"
+
+namespace Day11a {
+
 struct DivisibilityTest {
 	DivisibilityTest() noexcept = default;
 
-	DivisibilityTest(int rhs) : Rhs(rhs) {};
+	DivisibilityTest(int rhs) : Rhs(rhs) {
+		[[unlikely]]
+		if(rhs == 0) {
+			aoc::crash("Cannot test for divisibility by 0");
+		}
+	};
 
 	bool operator()(int lhs) const {
 		return lhs % Rhs == 0;
@@ -22,10 +34,36 @@ private:
 	int Rhs{};
 };
 
-void crash(std::string const& message) {
-	std::cerr << message << '\n';
-	assert(false);
-	exit(1);
+using aoc::crash;
+
+// The parser takes the notes apart by position, so their layout is checked up front.
+void checkNotes(std::vector<std::string_view> const& lines) {
+	static constexpr std::array<std::string_view, 6> prefixes{
+		"Monkey ",
+		"  Starting items:",
+		"  Operation: new = ",
+		"  Test: divisible by ",
+		"    If true: throw to monkey ",
+		"    If false: throw to monkey "
+	};
+
+	for(std::size_t i = 0; i < lines.size(); ++i) {
+		auto const& line = lines[i];
+		auto const lineInNote = i % 7;
+
+		bool const isValid = lineInNote == prefixes.size() ? line.empty() :
+			line.starts_with(prefixes[lineInNote]) && (lineInNote != 2 || std::ranges::count(line.substr(prefixes[2].size()), ' ') == 2);
+
+		[[unlikely]]
+		if(!isValid) {
+			crash("Line " + std::to_string(i + 1) + " does not fit the monkey notes");
+		}
+	}
+
+	[[unlikely]]
+	if(lines.size() % 7 != prefixes.size() && lines.size() % 7 != 0) {
+		crash("The notes of the last monkey are incomplete");
+	}
 }
 
 struct ThrownItem {
@@ -69,6 +107,10 @@ public:
 		TestFailTarget = fail;
 	}
 
+	bool ThrowsWithin(int monkeyCount) const {
+		return TestPassTarget >= 0 && TestPassTarget < monkeyCount && TestFailTarget >= 0 && TestFailTarget < monkeyCount;
+	}
+
 	int GetInspectionCount() const {
 		return InspectionCounter;
 	}
@@ -88,35 +130,13 @@ private:
 	int TestFailTarget{};
 };
 
-int strToInt(std::string_view str) {
-	[[likely]]
-	if(int result; std::from_chars(str.data(), str.data() + str.length(), result).ec == std::errc{}) {
-		return result;
-	}
-
-	crash("Could not parse int " + std::string(str));
-
-	return 0;
-}
-
-int main() {
-	std::ifstream input("input.txt");
-
-	[[unlikely]]
-	if(!input.is_open()) {
-		crash("Could not open the input file");
-	}
-
+aoc::Answers solve(std::string_view input) {
 	std::vector<Monkey> monkeys{};
 
 	{
-		std::string line{};
-	
-		std::vector<std::string> lines{};
+		auto const lines = aoc::splitLines(input);
 
-		while(std::getline(input, line)) {
-			lines.emplace_back(line);
-		}
+		checkNotes(lines);
 		
 		auto monkeysRange = lines |
 			std::views::chunk(7) |
@@ -134,7 +154,7 @@ int main() {
 							int(std::distance(substr.begin(), substr.end())) - (substr.back() == ',' ? 1 : 0)
 						);
 					}) |
-					std::views::transform(&strToInt);
+					std::views::transform(&aoc::parseInt<int>);
 				
 				Monkey monkey{};
 
@@ -167,7 +187,7 @@ int main() {
 							transform = std::multiplies<int>{};
 							break;
 						default:
-							crash("Invalid operand " + equationOperator);
+							crash("Invalid operand " + std::string(1, equationOperator));
 						}
 
 						std::string_view const equationOperand1(&*operand1range.begin(), std::distance(operand1range.begin(), operand1range.end()));
@@ -183,14 +203,14 @@ int main() {
 							isOperand1variable = true;
 						}
 						else {
-							operand1value = strToInt(equationOperand1);
+							operand1value = aoc::parseInt(equationOperand1);
 						}
 
 						if(equationOperand2 == "old") {
 							isOperand2variable = true;
 						}
 						else {
-							operand2value = strToInt(equationOperand2);
+							operand2value = aoc::parseInt(equationOperand2);
 						}
 
 						return [isOperand1variable, isOperand2variable, operand1value, operand2value, transform](int value) -> int {
@@ -210,7 +230,7 @@ int main() {
 					std::views::transform([](auto const& stringRange) -> std::string_view {
 						return std::string_view(&*stringRange.begin(), std::distance(stringRange.begin(), stringRange.end())); 
 					}) |
-					std::views::transform(&strToInt);
+					std::views::transform(&aoc::parseInt<int>);
 
 				monkey.SetDecisionTest(*decisionTest.begin());
 
@@ -226,7 +246,7 @@ int main() {
 						std::views::transform([](auto const& stringRange) -> std::string_view {
 							return std::string_view(&*stringRange.begin(), std::distance(stringRange.begin(), stringRange.end())); 
 						}) |
-						std::views::transform(&strToInt);
+						std::views::transform(&aoc::parseInt<int>);
 
 						return *lastNumber.begin();
 					});
@@ -241,14 +261,27 @@ int main() {
 
 		monkeys.insert(monkeys.end(), monkeysRange.begin(), monkeysRange.end());
 	}
-	input.close();
+
+	[[unlikely]]
+	if(monkeys.size() < 2) {
+		crash("Monkey business needs at least two monkeys");
+	}
+
+	for(auto const& monkey : monkeys) {
+		[[unlikely]]
+		if(!monkey.ThrowsWithin(int(monkeys.size()))) {
+			crash("A monkey throws to a monkey that is not in the notes");
+		}
+	}
+
+	aoc::markParsed();
 
 	int const rounds = 20;
 
 	std::stack<ThrownItem> thrownItems{};
 
 	for(int round = 0; round < 20; ++round) {
-		std::cout << "Round: " << round << '\n';
+		AOC_DEBUG("Round: " << round << '\n');
 		
 		for(int i = 0;  auto & monkey : monkeys) {
 			monkey.ThrowItems(thrownItems);
@@ -259,14 +292,14 @@ int main() {
 
 				monkeys[recipient].AcquireItem(item);
 
-				std::cout << "\tMonkey " << i << " throws item " << item << " to Monkey " << recipient << ".\n";
+				AOC_TRACE("\tMonkey " << i << " throws item " << item << " to Monkey " << recipient << ".\n");
 			}
 			++i;
 		}
 
 		for(int i = 0;  auto const& monkey : monkeys) {
 
-			std::cout << "[" << i++ << "]Inspections: " << monkey.GetInspectionCount() << '\n';
+			AOC_DEBUG("[" << i++ << "]Inspections: " << monkey.GetInspectionCount() << '\n');
 		}
 
 	}
@@ -281,7 +314,19 @@ int main() {
 	});
 
 
-	std::cout << "Monkey business level: " << (sortedMonkeys[0].GetInspectionCount() *  sortedMonkeys[1].GetInspectionCount()) << std::endl;
+	return { .Part1 = (long long)(sortedMonkeys[0].GetInspectionCount() *  sortedMonkeys[1].GetInspectionCount()) };
+}
+
+}
+
+#ifndef AOC_DRIVER
+int main() {
+	aoc::PuzzleInput input("input.txt");
+
+	auto const answers = Day11a::solve(input.Data());
+
+	std::cout << "Monkey business level: " << aoc::toString(answers.Part1) << std::endl;
 
 	return 0;
-}
\ No newline at end of file
+}
+#endif
\ No newline at end of file
@@ -1,19 +1,31 @@
 #include <algorithm>
-#include <cassert>
-#include <charconv>
-#include <fstream>
+#include <array>
 #include <functional>
 #include <iostream>
 #include <numeric>
 #include <ranges>
-#include <stack>
 #include <string>
+#include <string_view>
 #include <vector>
 
+#include "../../Common/crash.h"
+#include "../../Common/input.h"
+#include "../../Common/log.h"
+#include "../../Common/numbers.h"
+#include "../../Common/solver.h"
+#include "../../Common/tasks.h"
+
+namespace Day11b {
+
 struct DivisibilityTest {
 	DivisibilityTest() noexcept = default;
 
-	DivisibilityTest(long long rhs) : Rhs(rhs) {};
+	DivisibilityTest(long long rhs) : Rhs(rhs) {
+		[[unlikely]]
+		if(rhs == 0) {
+			aoc::crash("Cannot test for divisibility by 0");
+		}
+	};
 
 	bool operator()(long long lhs) const {
 		return lhs % Rhs == 0L;
@@ -27,10 +39,36 @@ private:
 	long long Rhs{};
 };
 
-void crash(std::string const& message) {
-	std::cerr << message << '\n';
-	assert(false);
-	exit(1);
+using aoc::crash;
+
+// The parser takes the notes apart by position, so their layout is checked up front.
+void checkNotes(std::vector<std::string_view> const& lines) {
+	static constexpr std::array<std::string_view, 6> prefixes{
+		"Monkey ",
+		"  Starting items:",
+		"  Operation: new = ",
+		"  Test: divisible by ",
+		"    If true: throw to monkey ",
+		"    If false: throw to monkey "
+	};
+
+	for(std::size_t i = 0; i < lines.size(); ++i) {
+		auto const& line = lines[i];
+		auto const lineInNote = i % 7;
+
+		bool const isValid = lineInNote == prefixes.size() ? line.empty() :
+			line.starts_with(prefixes[lineInNote]) && (lineInNote != 2 || std::ranges::count(line.substr(prefixes[2].size()), ' ') == 2);
+
+		[[unlikely]]
+		if(!isValid) {
+			crash("Line " + std::to_string(i + 1) + " does not fit the monkey notes");
+		}
+	}
+
+	[[unlikely]]
+	if(lines.size() % 7 != prefixes.size() && lines.size() % 7 != 0) {
+		crash("The notes of the last monkey are incomplete");
+	}
 }
 
 struct ThrownItem {
@@ -54,20 +92,18 @@ public:
 
 	void SetDecisionTest(DivisibilityTest&& decisionTest) {
 		DecisionTest = std::move(decisionTest);
-		modulo = std::lcm(modulo, decisionTest.GetRhs());
 	}
 
-	void ThrowItems(std::stack<ThrownItem>& thrownItems) {
-		for(auto const& item : Items) {
-			auto const newWorryLevel = WorryTrasformation(item) % modulo;
-			++InspectionCounter;
-			auto const decisionTestResult = DecisionTest(newWorryLevel);
-			auto const target = decisionTestResult ? TestPassTarget : TestFailTarget;
+	ThrownItem Inspect(long long item, long long modulo) const {
+		auto const newWorryLevel = WorryTrasformation(item) % modulo;
+		auto const decisionTestResult = DecisionTest(newWorryLevel);
+		auto const target = decisionTestResult ? TestPassTarget : TestFailTarget;
 
-			thrownItems.push(ThrownItem{ .WorryLevel = newWorryLevel, .Recipient = target });
-		}
+		return ThrownItem{ .WorryLevel = newWorryLevel, .Recipient = target };
+	}
 
-		Items.clear();
+	std::vector<long long> const& GetItems() const {
+		return Items;
 	}
 
 	void SetTargets(int pass, int fail) {
@@ -75,8 +111,12 @@ public:
 		TestFailTarget = fail;
 	}
 
-	long long GetInspectionCount() const {
-		return InspectionCounter;
+	bool ThrowsWithin(int monkeyCount) const {
+		return TestPassTarget >= 0 && TestPassTarget < monkeyCount && TestFailTarget >= 0 && TestFailTarget < monkeyCount;
+	}
+
+	long long GetDecisionDivisor() const {
+		return DecisionTest.GetRhs();
 	}
 
 private:
@@ -86,47 +126,19 @@ private:
 
 	std::function<long long(long long)> BoredTransformation{};
 
-	long long InspectionCounter{ 0 };
-
 	DivisibilityTest DecisionTest{};
 
 	int TestPassTarget{};
 	int TestFailTarget{};
-
-	static long long modulo;
 };
 
-long long Monkey::modulo = 1;
-
-int strToInt(std::string_view str) {
-	[[likely]]
-	if(int result; std::from_chars(str.data(), str.data() + str.length(), result).ec == std::errc{}) {
-		return result;
-	}
-
-	crash("Could not parse int " + std::string(str));
-
-	return 0;
-}
-
-int main() {
-	std::ifstream input("input.txt");
-
-	[[unlikely]]
-	if(!input.is_open()) {
-		crash("Could not open the input file");
-	}
-
+aoc::Answers solve(std::string_view input) {
 	std::vector<Monkey> monkeys{};
 
 	{
-		std::string line{};
-	
-		std::vector<std::string> lines{};
+		auto const lines = aoc::splitLines(input);
 
-		while(std::getline(input, line)) {
-			lines.emplace_back(line);
-		}
+		checkNotes(lines);
 		
 		auto monkeysRange = lines |
 			std::views::chunk(7) |
@@ -144,7 +156,7 @@ int main() {
 							int(std::distance(substr.begin(), substr.end())) - (substr.back() == ',' ? 1 : 0)
 						);
 					}) |
-					std::views::transform(&strToInt);
+					std::views::transform(&aoc::parseInt<int>);
 				
 				Monkey monkey{};
 
@@ -177,7 +189,7 @@ int main() {
 							transform = std::multiplies<long long>{};
 							break;
 						default:
-							crash("Invalid operand " + equationOperator);
+							crash("Invalid operand " + std::string(1, equationOperator));
 						}
 
 						std::string_view const equationOperand1(&*operand1range.begin(), std::distance(operand1range.begin(), operand1range.end()));
@@ -193,14 +205,14 @@ int main() {
 							isOperand1variable = true;
 						}
 						else {
-							operand1value = strToInt(equationOperand1);
+							operand1value = aoc::parseInt(equationOperand1);
 						}
 
 						if(equationOperand2 == "old") {
 							isOperand2variable = true;
 						}
 						else {
-							operand2value = strToInt(equationOperand2);
+							operand2value = aoc::parseInt(equationOperand2);
 						}
 
 						return [isOperand1variable, isOperand2variable, operand1value, operand2value, transform](long long value) -> long long {
@@ -220,7 +232,7 @@ int main() {
 					std::views::transform([](auto const& stringRange) -> std::string_view {
 						return std::string_view(&*stringRange.begin(), std::distance(stringRange.begin(), stringRange.end())); 
 					}) |
-					std::views::transform(&strToInt);
+					std::views::transform(&aoc::parseInt<int>);
 
 				monkey.SetDecisionTest(*decisionTest.begin());
 
@@ -236,7 +248,7 @@ int main() {
 						std::views::transform([](auto const& stringRange) -> std::string_view {
 							return std::string_view(&*stringRange.begin(), std::distance(stringRange.begin(), stringRange.end())); 
 						}) |
-						std::views::transform(&strToInt);
+						std::views::transform(&aoc::parseInt<int>);
 
 						return *lastNumber.begin();
 					});
@@ -251,47 +263,86 @@ int main() {
 
 		monkeys.insert(monkeys.end(), monkeysRange.begin(), monkeysRange.end());
 	}
-	input.close();
 
-	int const rounds = 10000;
+	[[unlikely]]
+	if(monkeys.size() < 2) {
+		crash("Monkey business needs at least two monkeys");
+	}
 
-	std::stack<ThrownItem> thrownItems{};
+	for(auto const& monkey : monkeys) {
+		[[unlikely]]
+		if(!monkey.ThrowsWithin(int(monkeys.size()))) {
+			crash("A monkey throws to a monkey that is not in the notes");
+		}
+	}
 
-	for(int round = 0; round < rounds; ++round) {
-		std::cout << "Round: " << round << '\n';
-		
-		for(int i = 0;  auto & monkey : monkeys) {
-			monkey.ThrowItems(thrownItems);
+	aoc::markParsed();
+
+	// worry levels only matter modulo the divisors, so keep them bounded by their lcm
+	long long modulo = 1;
 
-			while(!thrownItems.empty()) {
-				auto const [item, recipient] = thrownItems.top();
-				thrownItems.pop();
+	for(auto const& monkey : monkeys) {
+		modulo = std::lcm(modulo, monkey.GetDecisionDivisor());
+	}
+
+	int const rounds = 10000;
 
-				monkeys[recipient].AcquireItem(item);
+	std::vector<ThrownItem> startingItems{};
 
-				//std::cout << "\tMonkey " << i << " throws item " << item << " to Monkey " << recipient << ".\n";
-			}
-			++i;
+	for(int i = 0; auto const& monkey : monkeys) {
+		for(auto const item : monkey.GetItems()) {
+			startingItems.emplace_back(ThrownItem{ .WorryLevel = item, .Recipient = i });
 		}
+		++i;
+	}
+
+	// Items never interact, so each one is followed through all rounds on its own. Monkeys take their turns
+	// in order, so an item thrown to a later monkey is inspected again in the same round, otherwise in the next.
+	auto inspectionCounts = aoc::parallelReduce(0, (long long)(startingItems.size()), std::vector<long long>(monkeys.size()), [&](std::vector<long long>& counts, long long idx) {
+		auto [item, holder] = startingItems[idx];
+
+		for(int round = 0; round < rounds; ++round) {
+			while(true) {
+				++counts[holder];
 
-		for(int i = 0;  auto const& monkey : monkeys) {
+				auto const [newItem, recipient] = monkeys[holder].Inspect(item, modulo);
 
-			std::cout << "[" << i++ << "]Inspections: " << monkey.GetInspectionCount() << '\n';
+				item = newItem;
+				bool const isSameRound = recipient > holder;
+				holder = recipient;
+
+				if(!isSameRound) {
+					break;
+				}
+			}
+		}
+	}, [](std::vector<long long> left, std::vector<long long> const& right) {
+		for(std::size_t i = 0; i < left.size(); ++i) {
+			left[i] += right[i];
 		}
 
+		return left;
+	});
+
+	for(int i = 0; auto const count : inspectionCounts) {
+		AOC_DEBUG("[" << i++ << "]Inspections: " << count << '\n');
 	}
 
-	std::vector<Monkey> sortedMonkeys(monkeys);
+	std::ranges::sort(inspectionCounts, std::greater<long long>{});
 
-	std::sort(
-		sortedMonkeys.begin(),
-		sortedMonkeys.end(),
-		[](Monkey const& a, Monkey const& b) -> bool {
-		return a.GetInspectionCount() > b.GetInspectionCount();
-	});
+	return { .Part2 = inspectionCounts[0] * inspectionCounts[1] };
+}
+
+}
 
+#ifndef AOC_DRIVER
+int main() {
+	aoc::PuzzleInput input("input.txt");
+
+	auto const answers = Day11b::solve(input.Data());
 
-	std::cout << "Monkey business level: " << (sortedMonkeys[0].GetInspectionCount() *  sortedMonkeys[1].GetInspectionCount()) << std::endl;
+	std::cout << "Monkey business level: " << aoc::toString(answers.Part2) << std::endl;
 
 	return 0;
-}
\ No newline at end of file
+}
+#endif
\ No newline at end of file
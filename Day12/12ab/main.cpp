@@ -1,49 +1,39 @@
 #include <array>
-#include <cassert>
-#include <fstream>
 #include <format>
 #include <iostream>
+#include <limits>
 #include <queue>
 #include <string>
 #include <tuple>
 #include <utility>
 #include <vector>
 
-void crash(std::string const& message) {
-	std::cerr << message;
-	assert(false);
-	exit(1);
-}
-
-std::vector<std::string> readInput(std::string const& fileName) {
-	std::ifstream input(fileName);
+#include "../../Common/crash.h"
+#include "../../Common/grid.h"
+#include "../../Common/input.h"
+#include "../../Common/log.h"
+#include "../../Common/solver.h"
 
-	[[unlikely]]
-	if(!input.is_open()) {
-		crash("Could not open the input file.");
-	}
+namespace Day12ab {
 
-	std::vector<std::string> rawMap;
+using aoc::crash;
 
-	std::string line;
-
-	while(std::getline(input, line)) {
-		rawMap.emplace_back(line);
+// Padded by one cell so the searches can look at every neighbour; the border is kept out of the search
+// by its path lengths instead (see getShortestPath).
+aoc::Grid2D<int> parseMap(std::vector<std::string_view> const& rawMap, int& startX, int& startY, int& endX, int& endY) {
+	
+	[[unlikely]]
+	if(rawMap.empty()) {
+		crash("The map is empty");
 	}
 
-	input.close();
-
-	return rawMap;
-}
-
-std::vector<std::vector<int>> parseMap(std::vector<std::string> const& rawMap, int& startX, int& startY, int& endX, int& endY) {
-	
-	std::vector<std::vector<int>> map{};
-	map.reserve(rawMap.size());
+	aoc::Grid2D<int> map(int(rawMap.front().size()), int(rawMap.size()), 0, 1);
 	
 	for(int y = 0; auto const& rawLine : rawMap) {
-		std::vector<int> line{};
-		line.reserve(rawMap.size());
+		[[unlikely]]
+		if(rawLine.size() != rawMap.front().size()) {
+			crash("Line " + std::to_string(y + 1) + " is not as wide as the first");
+		}
 
 		for(int x = 0; auto const c : rawLine) {
 			int height = -1;
@@ -58,20 +48,26 @@ std::vector<std::vector<int>> parseMap(std::vector<std::string> const& rawMap, i
 				endY = y;
 				height = int('z' - 'a');
 			}
-			else {
+			else if(c >= 'a' && c <= 'z') {
 				height = int(c - 'a');
 			}
+			else {
+				crash("Invalid height " + std::string(1, c));
+			}
 
-			line.emplace_back(height);
+			map(x, y) = height;
 
 			++x;
 		}
 
-		map.emplace_back(std::move(line));
-
 		++y;
 	}
 
+	[[unlikely]]
+	if(startX < 0 || endX < 0) {
+		crash("The map has no start or no end");
+	}
+
 	return map;
 }
 
@@ -87,45 +83,36 @@ struct SearchNode {
 	int y;
 };
 
-struct Boolean {
-	Boolean() noexcept = default;
-
-	Boolean(bool value) noexcept : Value(value) {}
-
-	operator bool() noexcept {
-		return Value;
-	}
-
-private:
-	bool Value{};
-};
-
-void printMap(std::vector<std::vector<int>> const& map) {
-	for(auto const& line : map) {
-		for(auto const& element : line) {
-			std::cout << std::format("{:4}", element == std::numeric_limits<int>::max() ? -2 : element);
+void printMap(aoc::Grid2D<int> const& map) {
+	for(int y = 0; y < map.GetHeight(); ++y) {
+		for(auto const& element : map.Row(y)) {
+			aoc::logOutput() << std::format("{:4}", element == std::numeric_limits<int>::max() ? -2 : element);
 		}
 
-		std::cout << '\n';
+		aoc::logOutput() << '\n';
 
 	}
 }
 
-int getShortestPath(std::vector<std::vector<int>> const& map, int startX, int startY, int endX, int endY, std::vector<std::vector<int>>& shortestPaths, bool(*heightCondition)(int, int) = [](int targetHeight, int currentHeight) {return targetHeight <= currentHeight + 1; }) {
-	std::vector<std::vector<Boolean>> isEnqueueds(map.size(), std::vector<Boolean>(map.front().size(), false));
+// The border of shortestPaths has to hold the smallest int: no path can improve on it, so the search
+// never leaves the map without checking the bounds.
+aoc::Grid2D<int> makeShortestPaths(aoc::Grid2D<int> const& map) {
+	return aoc::Grid2D<int>(map.GetWidth(), map.GetHeight(), std::numeric_limits<int>::max(), 1, std::numeric_limits<int>::min());
+}
+
+int getShortestPath(aoc::Grid2D<int> const& map, int startX, int startY, int endX, int endY, aoc::Grid2D<int>& shortestPaths, bool(*heightCondition)(int, int) = [](int targetHeight, int currentHeight) {return targetHeight <= currentHeight + 1; }) {
+	aoc::Grid2D<bool> isEnqueueds(map.GetWidth(), map.GetHeight(), false, 1);
 
 	std::queue<SearchNode> bfs;
 
 	auto enqueue = [&shortestPaths, &isEnqueueds, &bfs](int x, int y, int pathLength) mutable -> void {
-		auto& shortestPath = shortestPaths[y][x];
+		auto& shortestPath = shortestPaths(x, y);
 
 		if(pathLength < shortestPath) {
 			shortestPath = pathLength;
 
-			auto& isEnqueued = isEnqueueds[y][x];
-
-			if(!isEnqueued) {
-				isEnqueued = true;
+			if(!isEnqueueds(x, y)) {
+				isEnqueueds(x, y) = true;
 				bfs.push(SearchNode{ .x = x, .y = y });
 			}
 		}
@@ -135,13 +122,9 @@ int getShortestPath(std::vector<std::vector<int>> const& map, int startX, int st
 		auto const [x, y] = bfs.front();
 		bfs.pop();
 
-		isEnqueueds[y][x] = false;
-
-		return { x, y, shortestPaths[y][x]};
-	};
+		isEnqueueds(x, y) = false;
 
-	auto isInMap = [&map](int x, int y) -> bool {
-		return x >= 0 && y >= 0 && y < int(map.size()) && x < int(map.front().size());
+		return { x, y, shortestPaths(x, y)};
 	};
 
 	enqueue(startX, startY, 0);
@@ -150,22 +133,21 @@ int getShortestPath(std::vector<std::vector<int>> const& map, int startX, int st
 		auto const [x, y, pathLength] = dequeue();
 
 		if(x == endX && y == endY) {
-			printMap(shortestPaths);
+			if constexpr(aoc::isLogged(aoc::LogLevel::Debug)) {
+				printMap(shortestPaths);
+			}
+
 			return pathLength;
 		}
 
-		int const currentHeight = map[y][x];
+		int const currentHeight = map(x, y);
 
 		for(auto const& [dx, dy] : directions) {
 			
 			int const targetX = x + dx;
 			int const targetY = y + dy;
 
-			if(!isInMap(targetX, targetY)) {
-				continue;
-			}
-
-			int const targetHeight = map[targetY][targetX];
+			int const targetHeight = map(targetX, targetY);
 
 			if(heightCondition(targetHeight, currentHeight)) {
 				enqueue(targetX, targetY, pathLength + 1);
@@ -175,42 +157,41 @@ int getShortestPath(std::vector<std::vector<int>> const& map, int startX, int st
 
 	} while(!bfs.empty());
 	
-	printMap(shortestPaths);
+	if constexpr(aoc::isLogged(aoc::LogLevel::Debug)) {
+		printMap(shortestPaths);
+	}
+
 	return -1;
 }
 
-int getShortestPath(std::vector<std::vector<int>> const& map, int startX, int startY, int endX, int endY) {
-	std::vector<std::vector<int>> shortestPaths(map.size(), std::vector<int>(map.front().size(), std::numeric_limits<int>::max()));
+int getShortestPath(aoc::Grid2D<int> const& map, int startX, int startY, int endX, int endY) {
+	auto shortestPaths = makeShortestPaths(map);
 
 	return getShortestPath(map, startX, startY, endX, endY, shortestPaths);
 }
 
-int getShortestPathFromUnknownStart(std::vector<std::vector<int>> const& map, int endX, int endY) {
-	std::vector<std::vector<int>> shortestPaths(map.size(), std::vector<int>(map.front().size(), std::numeric_limits<int>::max()));
+int getShortestPathFromUnknownStart(aoc::Grid2D<int> const& map, int endX, int endY) {
+	auto shortestPaths = makeShortestPaths(map);
 
 	getShortestPath(map, endX, endY, -1, -1, shortestPaths, [](int targetHeight, int currentHeight) {return targetHeight >= currentHeight - 1; });
 
 	int shortestPath = std::numeric_limits<int>::max();
 
-	for(int y = 0; auto const& line : map) {
-		for(int x = 0; auto const& element : line) {
+	for(int y = 0; y < map.GetHeight(); ++y) {
+		for(int x = 0; x < map.GetWidth(); ++x) {
 			
-			if(map[y][x] == 0) {
-				shortestPath = std::min(shortestPath, shortestPaths[y][x]);
+			if(map(x, y) == 0) {
+				shortestPath = std::min(shortestPath, shortestPaths(x, y));
 			}
-
-			++x;
 		}
-
-		++y;
 	}
 
 	return shortestPath;
 }
 
-int main() {
+aoc::Answers solve(std::string_view input) {
 
-	std::vector<std::vector<int>> map;
+	aoc::Grid2D<int> map;
 
 	int startX = -1;
 	int startY = -1;
@@ -218,19 +199,34 @@ int main() {
 	int endY = -1;
 	
 	{
-		auto rawMap = readInput("input.txt");
+		auto const rawMap = aoc::splitLines(input);
 	
 		map = parseMap(rawMap, startX, startY, endX, endY);
 	}
 
+	aoc::markParsed();
+
 	int const shortestPath = getShortestPath(map, startX, startY, endX, endY);
-	std::cout << '\n';
+	AOC_DEBUG('\n');
 	int const shortestPathFromAnywhere = getShortestPathFromUnknownStart(map, endX, endY);
 
-	std::cout << "Shortest path: " << shortestPath << std::endl;
+	return { .Part1 = shortestPath, .Part2 = shortestPathFromAnywhere };
+
+}
+
+}
+
+#ifndef AOC_DRIVER
+int main() {
+	aoc::PuzzleInput input("input.txt");
 
-	std::cout << "Shortest path from anywhere: " << shortestPathFromAnywhere << std::endl;
+	auto const answers = Day12ab::solve(input.Data());
+
+	std::cout << "Shortest path: " << aoc::toString(answers.Part1) << std::endl;
+
+	std::cout << "Shortest path from anywhere: " << aoc::toString(answers.Part2) << std::endl;
 
 	return 0;
 
-}
\ No newline at end of file
+}
+#endif
\ No newline at end of file
@@ -1,6 +1,4 @@
 #include <algorithm>
-#include <charconv>
-#include <fstream>
 #include <iostream>
 #include <ranges>
 #include <stack>
@@ -9,43 +7,13 @@
 #include <variant>
 #include <vector>
 
-void crash(std::string const& message) {
-	std::cerr << message << '\n';
-	std::terminate();
-}
-
-std::vector<std::string> readInput(std::string const& fileName) {
-	std::ifstream input(fileName);
-
-	[[unlikely]]
-	if(!input.is_open()) {
-		crash("Could not open the input file.");
-	}
-
-	std::vector<std::string> lines{};
-
-	{
-		std::string line;
-
-		while(std::getline(input, line)) {
-			lines.emplace_back(line);
-		}
-	}
+#include "../../Common/crash.h"
+#include "../../Common/input.h"
+#include "../../Common/log.h"
+#include "../../Common/numbers.h"
+#include "../../Common/solver.h"
 
-	return lines;
-}
-
-int strToInt(std::string_view str) {
-	
-	[[likely]]
-	if(int result; std::from_chars(str.data(), str.data() + str.length(), result).ec == std::errc{}) {
-		return result;
-	}
-
-	crash("Could not parse int: " + std::string(str));
-
-	return 0;
-}
+namespace Day13ab {
 
 namespace Packets {
 	struct IntPacketElement {
@@ -78,14 +46,19 @@ Packet parsePacket(std::string_view rawPacket) {
 
 	auto finishBuffer = [&intBuffer, &push]() mutable -> void {
 		if(!intBuffer.empty()) {
-			int value = strToInt(intBuffer);
+			int value = aoc::parseInt(intBuffer);
 			intBuffer.clear();
 
 			push.template operator()<Packets::IntPacketElement>().integer = value;
 		}
 	};
 
-	if(rawPacket.length() <= 2) {
+	[[unlikely]]
+	if(rawPacket.length() < 2 || rawPacket.front() != '[' || rawPacket.back() != ']') {
+		aoc::crash("Packet " + std::string(rawPacket) + " is not a list");
+	}
+
+	if(rawPacket.length() == 2) {
 		return packetContainer;
 	}
 
@@ -106,6 +79,11 @@ Packet parsePacket(std::string_view rawPacket) {
 		case ']': 
 			finishBuffer();
 
+			[[unlikely]]
+			if(parentPackets.size() == 1) {
+				aoc::crash("Packet " + std::string(rawPacket) + " closes more lists than it opens");
+			}
+
 			parentPackets.pop();
 			break;
 
@@ -117,10 +95,15 @@ Packet parsePacket(std::string_view rawPacket) {
 
 	finishBuffer();
 
+	[[unlikely]]
+	if(parentPackets.size() != 1) {
+		aoc::crash("Packet " + std::string(rawPacket) + " opens more lists than it closes");
+	}
+
 	return packetContainer;
 }
 
-std::vector<std::pair<Packet, Packet>> parseLines(std::vector<std::string> const& lines) {
+std::vector<std::pair<Packet, Packet>> parseLines(std::vector<std::string_view> const& lines) {
 
 	std::vector<std::pair<Packet, Packet>> packetPairs{};
 
@@ -139,17 +122,17 @@ std::vector<std::pair<Packet, Packet>> parseLines(std::vector<std::string> const
 struct PrintPackets {
 
 	void operator()(Packets::IntPacketElement const& intPacket) const {
-		std::cout << intPacket.integer << ",";
+		aoc::logOutput() << intPacket.integer << ",";
 	}
 
 	void operator()(Packets::ListPacketElement const& listPacket) const {
-		std::cout << '[';
+		aoc::logOutput() << '[';
 
 		for(auto const& packet : listPacket.list) {
 			std::visit(PrintPackets{}, packet);
 		}
 
-		std::cout << ']';
+		aoc::logOutput() << ']';
 	}
 };
 
@@ -210,7 +193,7 @@ int sumCorrectPacketPairsIndices(std::vector<std::pair<Packet, Packet>> const& p
 		if(comparePackets(leftPacket, rightPacket) >= 0) {
 			correctPairsIndicesSum += pairIdx;
 
-			std::cout << "Pair " << pairIdx << " is correct.\n";
+			AOC_DEBUG("Pair " << pairIdx << " is correct.\n");
 		}
 
 		++pairIdx;
@@ -257,12 +240,12 @@ int getDecoderKey(std::vector<std::pair<Packet, Packet>> const& packetPairs) {
 	for(int packetIdx = 1; Packet const& packet : allPackets) {
 		
 		if(comparePackets(packet, dividerPacket1) == 0) {
-			std::cout << "Found divider packet 1 at position " << packetIdx << '\n';
+			AOC_DEBUG("Found divider packet 1 at position " << packetIdx << '\n');
 			dividerPacket1idx = packetIdx;
 		}
 
 		if(comparePackets(packet, dividerPacket2) == 0) {
-			std::cout << "Found divider packet 2 at position " << packetIdx << '\n';
+			AOC_DEBUG("Found divider packet 2 at position " << packetIdx << '\n');
 			dividerPacket2idx = packetIdx;
 		}
 
@@ -272,19 +255,34 @@ int getDecoderKey(std::vector<std::pair<Packet, Packet>> const& packetPairs) {
 	return dividerPacket1idx * dividerPacket2idx;
 }
 
-int main() {
+aoc::Answers solve(std::string_view input) {
 
-	auto inputLines = readInput("input.txt");
+	auto const inputLines = aoc::splitLines(input);
 
 	auto packetPairs = parseLines(inputLines);
 
-	auto correctPacketPairsIndicesSum = sumCorrectPacketPairsIndices(packetPairs);
+	aoc::markParsed();
 
-	std::cout << "Correct packet pairs indices sum: " << correctPacketPairsIndicesSum << std::endl;
+	auto correctPacketPairsIndicesSum = sumCorrectPacketPairsIndices(packetPairs);
 
 	auto decoderKey = getDecoderKey(packetPairs);
 
-	std::cout << "Decoder key: " << decoderKey << std::endl;
+	return { .Part1 = correctPacketPairsIndicesSum, .Part2 = decoderKey };
+}
+
+}
+
+#ifndef AOC_DRIVER
+int main() {
+
+	aoc::PuzzleInput input("input.txt");
+
+	auto const answers = Day13ab::solve(input.Data());
+
+	std::cout << "Correct packet pairs indices sum: " << aoc::toString(answers.Part1) << std::endl;
+
+	std::cout << "Decoder key: " << aoc::toString(answers.Part2) << std::endl;
 
 	return 0;
-}
\ No newline at end of file
+}
+#endif
\ No newline at end of file
@@ -1,49 +1,19 @@
-#include <charconv>
-#include <fstream>
 #include <iostream>
+#include <limits>
 #include <ranges>
 #include <stack>
 #include <string>
 #include <tuple>
 #include <vector>
 
-void crash(std::string const& message) {
-	std::cerr << message << std::endl;
-	std::terminate();
-}
-
-std::vector<std::string> readInputLines(std::string const& fileName) {
-	std::ifstream input(fileName);
-
-	[[unlikely]]
-	if(!input.is_open()) {
-		crash("Could not open the input file.");
-	}
-
-	std::vector<std::string> lines{};
-
-	{
-		std::string line;
-
-		while(std::getline(input, line)) {
-			lines.emplace_back(line);
-		}
-	}
-
-	input.close();
+#include "../../Common/grid.h"
+#include "../../Common/input.h"
+#include "../../Common/log.h"
+#include "../../Common/metrics.h"
+#include "../../Common/numbers.h"
+#include "../../Common/solver.h"
 
-	return lines;
-}
-
-int strToInt(std::string_view str) {
-	[[likely]]
-	if(int result; std::from_chars(str.data(), str.data() + str.length(), result).ec == std::errc{}) {
-		return result;
-	}
-
-	crash("Could not parse int " + std::string(str));
-	return 0;
-}
+namespace Day14a {
 
 struct Coord {
 	int x, y;
@@ -63,8 +33,8 @@ std::vector<Coord> parseLine(std::string_view line) {
 				auto const& xRange = *chunkRange.begin();
 				auto const& yRange = *std::next(chunkRange.begin());
 
-				int const x = strToInt(std::string_view(xRange));
-				int const y = strToInt(std::string_view(yRange));
+				int const x = aoc::parseInt(std::string_view(xRange));
+				int const y = aoc::parseInt(std::string_view(yRange));
 
 				return Coord{ .x = x, .y = y };
 			});
@@ -77,7 +47,7 @@ std::vector<Coord> parseLine(std::string_view line) {
 
 }
 
-std::vector<std::vector<Coord>> parseInput(std::vector<std::string> const& rawLines) {
+std::vector<std::vector<Coord>> parseInput(std::vector<std::string_view> const& rawLines) {
 
 	std::vector<std::vector<Coord>> parsedCoords{};
 
@@ -112,7 +82,8 @@ enum class FieldType : char {
 	Air = '.',
 	Stone = '#',
 	Sand = 'o',
-	Spawner = '+'
+	Spawner = '+',
+	Abyss = ' '
 };
 
 int getDirection(int a, int b) {
@@ -132,11 +103,11 @@ public:
 	Cave(int minX, int minY, int maxX, int maxY, Coord sandSource) : 
 		MinX(minX), MaxX(maxX), MinY(minY), MaxY(maxY),
 		Width(maxX + 1 - minX), Height(maxY + 1 - minY),
-		CaveMap(Height, std::vector<FieldType>(Width, FieldType::Air)),
-		SandSourceMapped(MapCoord(sandSource))
+		SandSourceMapped(MapCoord(sandSource)),
+		CaveMap(Width, Height, FieldType::Air, 1, FieldType::Abyss)
 	{
 		SandPath.push(SandSourceMapped);
-		CaveMap[SandSourceMapped.y][SandSourceMapped.x] = FieldType::Spawner;
+		CaveMap(SandSourceMapped.x, SandSourceMapped.y) = FieldType::Spawner;
 	}
 
 	void AddStonePath(std::vector<Coord> const& coords) {		
@@ -146,12 +117,12 @@ public:
 	}
 
 	void PrintMap() const {
-		std::cout << "Map:\n";
-		for(auto const& row : CaveMap) {
-			for(auto const& field : row) {
-				std::cout << std::to_underlying(field);
+		aoc::logOutput() << "Map:\n";
+		for(int y = 0; y < Height; ++y) {
+			for(auto const& field : CaveMap.Row(y)) {
+				aoc::logOutput() << std::to_underlying(field);
 			}
-			std::cout << '\n';
+			aoc::logOutput() << '\n';
 		}
 	}
 
@@ -170,73 +141,43 @@ public:
 			}
 
 			if(!isSpaceFound) {
-				CaveMap[coord.y][coord.x] = FieldType::Sand;
+				CaveMap(coord.x, coord.y) = FieldType::Sand;
 				SandPath.pop();
+				AOC_COUNT("day14a.sand_units");
 				return true;
 			}
 
 			// space found
 			SandPath.push(nextCoord);
+			AOC_COUNT("day14a.sand_moves");
 		} while(true);
 
 	}
 
 protected:
+	// The map is surrounded by abyss, so falling out of it is found the same way as free space is.
 	void FindFreeSpaceUnder(Coord const& inCoord, Coord& outCoord, bool& isSpaceFound, bool& isOutOfMap) const {
 		int const nextY = inCoord.y + 1;
 
-		auto fellOutOfMap = [&isSpaceFound, &isOutOfMap]() mutable -> void {
-			isSpaceFound = false;
-			isOutOfMap = true;			
-		};
-
-		auto foundSpace = [&outCoord, &isSpaceFound, &isOutOfMap](Coord const& coord) mutable -> void {
-			outCoord = coord;
-			isSpaceFound = true;
-			isOutOfMap = false;
-		};
-
-		if(nextY >= Height) {
-			fellOutOfMap();
-			return;
-		}
-
-		if(IsAirAt(inCoord.x, nextY)) {
-			foundSpace(Coord{ .x = inCoord.x, .y = nextY });
-			return;
-		}
-
-		int const leftX = inCoord.x - 1;
+		for(int const x : { inCoord.x, inCoord.x - 1, inCoord.x + 1 }) {
+			auto const field = CaveMap(x, nextY);
 
-		if(leftX < 0) {
-			fellOutOfMap();
-			return;
-		}
-
-		if(IsAirAt(leftX, nextY)) {
-			foundSpace(Coord{ .x = leftX, .y = nextY });
-			return;
-		}
-
-		int const rightX = inCoord.x + 1;
-
-		if(rightX >= Width) {
-			fellOutOfMap();
-			return;
-		}
+			if(field == FieldType::Abyss) {
+				isSpaceFound = false;
+				isOutOfMap = true;
+				return;
+			}
 
-		if(IsAirAt(rightX, nextY)) {
-			foundSpace(Coord{ .x = rightX, .y = nextY });
-			return;
+			if(field == FieldType::Air) {
+				outCoord = Coord{ .x = x, .y = nextY };
+				isSpaceFound = true;
+				isOutOfMap = false;
+				return;
+			}
 		}
 
 		isSpaceFound = false;
 		isOutOfMap = false;
-		return;
-	}
-
-	bool IsAirAt(int x, int y) const {
-		return CaveMap[y][x] == FieldType::Air;
 	}
 
 	void AddStoneLine(Coord const& a, Coord const& b) {
@@ -244,11 +185,11 @@ protected:
 		int const dy = getDirection(a.y, b.y);
 
 		for(int y = a.y; y != b.y + dy; y += dy) {
-			CaveMap[y][a.x] = FieldType::Stone;
+			CaveMap(a.x, y) = FieldType::Stone;
 		}
 
 		for(int x = a.x; x != b.x + dx; x += dx) {
-			CaveMap[a.y][x] = FieldType::Stone;
+			CaveMap(x, a.y) = FieldType::Stone;
 		}
 	}
 
@@ -258,16 +199,18 @@ protected:
 
 	int MinX, MaxX, MinY, MaxY, Width, Height;
 	Coord SandSourceMapped;
-	std::vector<std::vector<FieldType>> CaveMap;
+	aoc::Grid2D<FieldType> CaveMap;
 	std::stack<Coord> SandPath{};
 };
 
-int main() {
+aoc::Answers solve(std::string_view input) {
 
-	auto rawLines = readInputLines("input.txt");
+	auto const rawLines = aoc::splitLines(input);
 
 	auto coords = parseInput(rawLines);
 
+	aoc::markParsed();
+
 	int minX, minY, maxX, maxY;
 
 	findExtremes(coords, minX, maxX, minY, maxY);
@@ -285,8 +228,24 @@ int main() {
 	for(; cave.DropSand(); ++i);
 
 	
-	cave.PrintMap();
-	std::cout << "Sand units: " << i << '\n';
+	if constexpr(aoc::isLogged(aoc::LogLevel::Debug)) {
+		cave.PrintMap();
+	}
+
+	return { .Part1 = i };
+}
+
+}
+
+#ifndef AOC_DRIVER
+int main() {
+
+	aoc::PuzzleInput input("input.txt");
+
+	auto const answers = Day14a::solve(input.Data());
+
+	std::cout << "Sand units: " << aoc::toString(answers.Part1) << '\n';
 
 	return 0;
-}
\ No newline at end of file
+}
+#endif
\ No newline at end of file
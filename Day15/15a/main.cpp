@@ -1,6 +1,4 @@
 #include <algorithm>
-#include <charconv>
-#include <fstream>
 #include <iostream>
 #include <map>
 #include <ranges>
@@ -8,64 +6,35 @@
 #include <tuple>
 #include <vector>
 
-void crash(std::string const& message) {
-	std::cerr << message << std::endl;
-	std::terminate();
-}
-
-std::vector<std::string> getInputLines(std::string const& fileName) {
-	std::fstream input(fileName);
-
-	[[unlikely]]
-	if(!input.is_open()) {
-		crash("Could not open the input file!");
-	}
-
-	std::vector<std::string> lines;
-
-	{
-		std::string line;
+#include "../../Common/crash.h"
+#include "../../Common/input.h"
+#include "../../Common/log.h"
+#include "../../Common/numbers.h"
+#include "../../Common/solver.h"
 
-		while(std::getline(input, line)) {
-			lines.emplace_back(line);
-		}
-	}
-
-	input.close();
-
-	return lines;
-}
-
-long long strToInt(std::string_view str) {
-	[[likely]]
-	if(long long result; std::from_chars(str.data(), str.data() + str.length(), result).ec == std::errc{}) {
-		return result;
-	}
-
-	crash("Could not convert " + std::string(str) + " to int.");
-	return 0;
-}
+namespace Day15a {
 
+using aoc::crash;
 
 class Intervals {
 public:
 	void AddInterval(long long start, long long end) {
-		std::cout << "Adding " << start << "..." << end << '\n';
+		AOC_TRACE("Adding " << start << "..." << end << '\n');
 		auto it = EndStarts.lower_bound(end);
 
 		if(it == EndStarts.end() || it->second > end) {
 			it = EndStarts.emplace(end, start).first;
-			std::cout << "\tAdded new!\n";
+			AOC_TRACE("\tAdded new!\n");
 		}
 		else {
 			if(it->second > start) {
 				end = it->first;
 				it->second = start;
-				std::cout << "\tEnd = " << end << "\n";
-				std::cout << "\tModified start to " << start << "\n";
+				AOC_TRACE("\tEnd = " << end << "\n");
+				AOC_TRACE("\tModified start to " << start << "\n");
 			}
 			else {
-				std::cout << "\tFully contained by start " << it->second << "\n";
+				AOC_TRACE("\tFully contained by start " << it->second << "\n");
 				return;
 			}
 		}
@@ -78,28 +47,27 @@ public:
 
 			if(rit == EndStarts.rend()) {
 				// no more intervals
-				std::cout << "\tReached end" << "\n";
+				AOC_TRACE("\tReached end" << "\n");
 				break;
 			}
 
-			auto val = *rit;
-			std::cout << "\tQuery: " << val.second << "..." << val.first << "\n";
+			AOC_TRACE("\tQuery: " << rit->second << "..." << rit->first << "\n");
 
 			if(rit->first < start) {
 				// the interval is too far
-				std::cout << "\t\tToo far" << "\n";
+				AOC_TRACE("\t\tToo far" << "\n");
 				break;
 			}
 
 			auto const extension = rit->second;
 
 			auto toBeRemoved = std::prev(rit.base());
-			std::cout << "\t\tRemoving " << toBeRemoved->second << "..." << toBeRemoved->first << "\n";
+			AOC_TRACE("\t\tRemoving " << toBeRemoved->second << "..." << toBeRemoved->first << "\n");
 			rit = std::make_reverse_iterator(std::prev(EndStarts.erase(toBeRemoved)));
 
 			if(extension <= start) {
 				// the interval is fully contained
-				std::cout << "\t\tInterval contained, interval extended to " << extension << "\n";
+				AOC_TRACE("\t\tInterval contained, interval extended to " << extension << "\n");
 
 				auto& currentStart = EndStarts[end];
 				currentStart = std::min(currentStart, extension);
@@ -162,60 +130,22 @@ struct Sensor {
 	Coord BeaconCoord;
 };
 
-std::vector<long long> extractInts(std::string_view str) {
-	auto it = str.begin();
-
-	static constexpr std::string_view digits("-0123456789");
-
-	std::vector<long long> values;
+std::vector<Sensor> parseSensors(std::string_view input) {
+	aoc::ExtractedInts numbers;
+	aoc::extractInts(input, numbers);
 
-	do {
-		auto numStart = std::string_view(it, str.end()).find_first_of(digits, 0);
-		
-		if(numStart == std::string_view::npos) {
-			break;
-		}
-
-		std::advance(it, numStart);
-
-		std::string_view substr(it, str.end());
+	std::vector<Sensor> sensors;
+	sensors.reserve(numbers.LineCount());
 
-		auto numEnd = substr.find_first_not_of(digits);
+	for(std::size_t line = 0; line < numbers.LineCount(); ++line) {
+		auto const values = numbers.Line(line);
 
-		if(numEnd == std::string_view::npos) {
-			numEnd = substr.length();
+		[[unlikely]]
+		if(values.size() != 4) {
+			crash("Line " + std::to_string(line + 1) + ": 4 numbers expected, got " + std::to_string(values.size()));
 		}
 
-		auto nextIt = std::next(it, numEnd);
-
-		auto const value = strToInt(std::string_view(it, nextIt));
-
-		values.emplace_back(value);
-
-		it = nextIt;
-
-	} while(true);
-
-	return values;
-}
-
-Sensor parseLine(std::string_view line) {
-	auto numbers = extractInts(line);
-
-	[[unlikely]]
-	if(numbers.size() != 4) {
-		crash("4 numbers expected, got " + std::to_string(numbers.size()));
-	}
-
-	return Sensor(Coord{ .x = numbers[0], .y = numbers[1] }, Coord{ .x = numbers[2], .y = numbers[3] });
-}
-
-std::vector<Sensor> parseLines(std::vector<std::string> const& lines) {
-	std::vector<Sensor> sensors;
-	sensors.reserve(lines.size());
-
-	for(auto const& line : lines) {
-		sensors.emplace_back(parseLine(line));
+		sensors.emplace_back(Coord{ .x = values[0], .y = values[1] }, Coord{ .x = values[2], .y = values[3] });
 	}
 
 	return sensors;
@@ -232,14 +162,26 @@ Intervals getExcludedIntervalsAtY(long long y, std::vector<Sensor> const& sensor
 	return intervals;
 }
 
-int main() {
-	auto lines = getInputLines("input.txt");
+aoc::Answers solve(std::string_view input) {
+	auto sensors = parseSensors(input);
 
-	auto sensors = parseLines(lines);
+	aoc::markParsed();
 
 	auto excludedIntervals = getExcludedIntervalsAtY(2000000, sensors);
 
-	std::cout << excludedIntervals.GetIntervalCoverSize() << std::endl;
+	return { .Part1 = excludedIntervals.GetIntervalCoverSize() };
+}
+
+}
+
+#ifndef AOC_DRIVER
+int main() {
+	aoc::PuzzleInput input("input.txt");
+
+	auto const answers = Day15a::solve(input.Data());
+
+	std::cout << aoc::toString(answers.Part1) << std::endl;
 
 	return 0;
-}
\ No newline at end of file
+}
+#endif
\ No newline at end of file
@@ -1,6 +1,4 @@
 #include <algorithm>
-#include <charconv>
-#include <fstream>
 #include <format>
 #include <iostream>
 #include <map>
@@ -10,43 +8,16 @@
 #include <unordered_set>
 #include <vector>
 
-void crash(std::string const& message) {
-	std::cerr << message << std::endl;
-	std::terminate();
-}
-
-std::vector<std::string> getInputLines(std::string const& fileName) {
-	std::fstream input(fileName);
-
-	[[unlikely]]
-	if(!input.is_open()) {
-		crash("Could not open the input file!");
-	}
-
-	std::vector<std::string> lines;
-
-	{
-		std::string line;
-
-		while(std::getline(input, line)) {
-			lines.emplace_back(line);
-		}
-	}
-
-	input.close();
-
-	return lines;
-}
+#include "../../Common/crash.h"
+#include "../../Common/input.h"
+#include "../../Common/log.h"
+#include "../../Common/numbers.h"
+#include "../../Common/solver.h"
+#include "../../Common/tasks.h"
 
-long long strToInt(std::string_view str) {
-	[[likely]]
-	if(long long result; std::from_chars(str.data(), str.data() + str.length(), result).ec == std::errc{}) {
-		return result;
-	}
+namespace Day15b {
 
-	crash("Could not convert " + std::string(str) + " to int.");
-	return 0;
-}
+using aoc::crash;
 
 namespace {
 
@@ -393,60 +364,22 @@ struct Sensor {
 	Coord BeaconCoord;
 };
 
-std::vector<long long> extractInts(std::string_view str) {
-	auto it = str.begin();
-
-	static constexpr std::string_view digits("-0123456789");
-
-	std::vector<long long> values;
-
-	do {
-		auto numStart = std::string_view(it, str.end()).find_first_of(digits, 0);
-		
-		if(numStart == std::string_view::npos) {
-			break;
-		}
+std::vector<Sensor> parseSensors(std::string_view input) {
+	aoc::ExtractedInts numbers;
+	aoc::extractInts(input, numbers);
 
-		std::advance(it, numStart);
-
-		std::string_view substr(it, str.end());
+	std::vector<Sensor> sensors;
+	sensors.reserve(numbers.LineCount());
 
-		auto numEnd = substr.find_first_not_of(digits);
+	for(std::size_t line = 0; line < numbers.LineCount(); ++line) {
+		auto const values = numbers.Line(line);
 
-		if(numEnd == std::string_view::npos) {
-			numEnd = substr.length();
+		[[unlikely]]
+		if(values.size() != 4) {
+			crash("Line " + std::to_string(line + 1) + ": 4 numbers expected, got " + std::to_string(values.size()));
 		}
 
-		auto nextIt = std::next(it, numEnd);
-
-		auto const value = strToInt(std::string_view(it, nextIt));
-
-		values.emplace_back(value);
-
-		it = nextIt;
-
-	} while(true);
-
-	return values;
-}
-
-Sensor parseLine(std::string_view line) {
-	auto numbers = extractInts(line);
-
-	[[unlikely]]
-	if(numbers.size() != 4) {
-		crash("4 numbers expected, got " + std::to_string(numbers.size()));
-	}
-
-	return Sensor(Coord{ .x = numbers[0], .y = numbers[1] }, Coord{ .x = numbers[2], .y = numbers[3] });
-}
-
-std::vector<Sensor> parseLines(std::vector<std::string> const& lines) {
-	std::vector<Sensor> sensors;
-	sensors.reserve(lines.size());
-
-	for(auto const& line : lines) {
-		sensors.emplace_back(parseLine(line));
+		sensors.emplace_back(Coord{ .x = values[0], .y = values[1] }, Coord{ .x = values[2], .y = values[3] });
 	}
 
 	return sensors;
@@ -497,10 +430,10 @@ std::unordered_set<long long> GetSuspiciousYs(std::vector<Line> const& lines) {
 	return result;
 }
 
-int main() {
-	auto lines = getInputLines("input.txt");
+aoc::Answers solve(std::string_view input) {
+	auto sensors = parseSensors(input);
 
-	auto sensors = parseLines(lines);
+	aoc::markParsed();
 
 	auto geometry = makeLines(sensors);
 
@@ -515,28 +448,42 @@ int main() {
 
 	auto intervals = getExcludedIntervalsAtY(2000000L, sensors);
 
-	std::cout << intervals.GetIntervalCoverSize() << std::endl;
+	long long const coverSize = intervals.GetIntervalCoverSize();
+
+	AOC_INFO("Suspicious ys: " << ys.size()  << '\n');
+
 
-	std::cout << "Suspicious ys: " << ys.size()  << '\n';
+	std::vector<long long> const candidateYs(ys.begin(), ys.end());
 
+	// every row is checked on its own; a later row wins like it did in the sequential scan
+	long long const tuningFrequency = aoc::parallelReduce(0, (long long)(candidateYs.size()), -1LL, [&](long long& found, long long idx) {
+		auto const y = candidateYs[idx];
 
-	for(auto const y : ys) {
 		if(y < 0 || y > limit) {
-			continue;
+			return;
 		}
-		
-		intervals = getExcludedIntervalsAtY(y, sensors);
 
-		auto xs = intervals.GetFreeSpaces(0, limit);
+		for(auto const x : getExcludedIntervalsAtY(y, sensors).GetFreeSpaces(0, limit)) {
+			found = 4000000L * x + y;
+		}
+	}, [](long long left, long long right) { return right != -1 ? right : left; });
 
-		if(xs.size() > 0) {
-			std::cout << "At y = " << y << " there are " << xs.size() << " xs.\n";
+	AOC_INFO("Tuning frequency: " << tuningFrequency << '\n');
 
-			for(auto const x : xs) {
-				std::cout << '\t' << x << " -> " << (4000000L * x + y) << '\n';
-			}
-		}
-	}
+	return { .Part1 = coverSize, .Part2 = tuningFrequency };
+}
+
+}
+
+#ifndef AOC_DRIVER
+int main() {
+	aoc::PuzzleInput input("input.txt");
+
+	auto const answers = Day15b::solve(input.Data());
+
+	std::cout << aoc::toString(answers.Part1) << '\n';
+	std::cout << aoc::toString(answers.Part2) << std::endl;
 
 	return 0;
-}
\ No newline at end of file
+}
+#endif
\ No newline at end of file
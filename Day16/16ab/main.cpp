@@ -1,23 +1,36 @@
+#include <algorithm>
+#include <array>
+#include <bit>
 #include <bitset>
-#include <charconv>
+#include <cstdint>
 #include <deque>
-#include <fstream>
 #include <iostream>
+#include <limits>
+#include <numeric>
 #include <ranges>
-#include <regex>
+#include <span>
 #include <stack>
 #include <string>
 #include <tuple>
-#include <unordered_map>
 #include <unordered_set>
+#include <utility>
 #include <vector>
 
-#include <omp.h>
+#include "../../Common/checkpoint.h"
+#include "../../Common/crash.h"
+#include "../../Common/grid.h"
+#include "../../Common/hashmap.h"
+#include "../../Common/input.h"
+#include "../../Common/metrics.h"
+#include "../../Common/pages.h"
+#include "../../Common/scanner.h"
+#include "../../Common/solver.h"
+#include "../../Common/tasks.h"
 
-void crash(std::string const& message) {
-	std::cerr << message << std::endl;
-	std::terminate();
-}
+namespace Day16ab {
+
+// Part of the result cache and checkpoint keys, see aoc::Solver::Version.
+constexpr int solverVersion = 2;
 
 struct Valve {
 	int id{};
@@ -26,71 +39,75 @@ struct Valve {
 	bool deleted{ false };
 };
 
-int strToInt(std::string const& str) {
-	[[likely]]
-	if(int result; std::from_chars(str.data(), str.data() + str.length(), result).ec == std::errc{}) {
-		return result;
+// Valve names are two capital letters, so they index a 26x26 table directly instead of being hashed.
+// Owned by a single parse, so several caves can be parsed and solved side by side.
+class VertexIds {
+public:
+	VertexIds() {
+		Ids.fill(-1);
 	}
 
-	crash("Could not parse int from " + str);
-	return 0;
-}
+	int GetVertexId(std::string_view name) {
+		int& id = Ids[IndexOf(name)];
 
-static std::unordered_map<std::string, int> ids;
-static std::unordered_map<int, std::string> names;
+		if(id < 0) {
+			id = int(Names.size());
+			Names.emplace_back(name);
+		}
 
-int getVertexId(std::string const& name) {
-	static int id = 0;
+		return id;
+	}
 
-	if(ids.count(name) > 0) {
-		return ids[name];
+	// -1 for a name never seen
+	int FindVertexId(std::string_view name) const {
+		return Ids[IndexOf(name)];
 	}
 
-	auto const myId = id++;
+	std::string_view GetVertexName(int vertexId) const {
+		return Names[vertexId];
+	}
 
-	names[myId] = name;
-	return ids[name] = myId;
-}
+private:
+	static constexpr int nLetters = 26;
 
-std::string const& getVertexName(int vertexId) {
-	return names[vertexId];
-}
+	static std::size_t IndexOf(std::string_view name) {
+		[[unlikely]]
+		if(name.size() != 2 || name[0] < 'A' || name[0] > 'Z' || name[1] < 'A' || name[1] > 'Z') {
+			aoc::crash("Valve name " + std::string(name) + " is not two capital letters");
+		}
 
-std::vector<Valve> parseLines(std::vector<std::string> const& lines) {
-	std::vector<Valve> valves;
-	valves.reserve(lines.size());
+		return std::size_t((name[0] - 'A') * nLetters + (name[1] - 'A'));
+	}
 
-	std::regex pattern("Valve ([A-Z]{2}) has flow rate=([0-9]+); tunnels? leads? to valves? ([A-Z, ]+)");
+	std::array<int, nLetters * nLetters> Ids;
+	// views into the input
+	std::vector<std::string_view> Names;
+};
 
-	std::smatch match;
+std::vector<Valve> parseLines(std::vector<std::string_view> const& lines, VertexIds& vertexIds) {
+	std::vector<Valve> valves;
+	valves.reserve(lines.size());
 
-	for(auto const& line : lines) {
-		[[unlikely]]
-		if(!std::regex_search(line, match, pattern)) {
-			crash("Could not match regex.");
-		}
+	for(std::size_t lineIdx = 0; lineIdx < lines.size(); ++lineIdx) {
+		aoc::Scanner scanner(lines[lineIdx], lineIdx + 1);
 
-		[[unlikely]]
-		if(match.size() != 4) {
-			crash("Got unexpected match group count.");
-		}
+		std::string_view valveName;
+		int flowRate{};
 
-		std::string const valveName = match[1];
-		std::string const flowRateRaw = match[2];
-		std::string const neighborsRaw = match[3];
+		scanner.Scan("Valve {} has flow rate={}; tunnels? leads? to valves? ", valveName, flowRate);
 
-		int const valveId = getVertexId(valveName);
-		int const flowRate = strToInt(flowRateRaw);
+		int const valveId = vertexIds.GetVertexId(valveName);
 
 		std::vector<int> neighbors;
 
-		for(auto const valveNameRange : neighborsRaw | std::views::split(std::string_view(", "))) {
-			std::string valveName(valveNameRange.begin(), valveNameRange.end());
+		do {
+			std::string_view neighborName;
+			scanner.Read(neighborName);
 
-			int const valveId = getVertexId(valveName);
+			neighbors.emplace_back(vertexIds.GetVertexId(neighborName));
+		} while(scanner.Skip(", "));
 
-			neighbors.emplace_back(valveId);
-		}
+		scanner.ExpectEnd();
 
 		valves.emplace_back(Valve{ .id = valveId, .flow = flowRate, .neighbors = std::move(neighbors) });
 	}
@@ -98,34 +115,16 @@ std::vector<Valve> parseLines(std::vector<std::string> const& lines) {
 	return valves;
 }
 
-std::vector<std::string> readLines(std::string const& fileName) {
-	std::ifstream input(fileName);
-
-	[[unlikely]]
-	if(!input.is_open()) {
-		crash("Could not open the input file");
-	}
-
-
-	std::vector<std::string> lines;
-
-	{
-		std::string line;
-
-		while(std::getline(input, line)) {
-			lines.emplace_back(line);
-		}
-	}
-
-	return lines;
-	
-}
-
+// every one of the lowest bits set, all 64 of them included
 constexpr
-int64_t getMaxMask(int64_t bits) {
-	return (int64_t(1) << bits) - 1;
+uint64_t getMaxMask(int64_t bits) {
+	return bits >= 64 ? ~uint64_t(0) : (uint64_t(1) << bits) - 1;
 }
 
+static_assert(getMaxMask(0) == 0);
+static_assert(getMaxMask(63) == ~uint64_t(0) >> 1);
+static_assert(getMaxMask(64) == ~uint64_t(0));
+
 constexpr
 int64_t selector(int64_t position) {
 	return int64_t(1) << position;
@@ -146,232 +145,678 @@ int64_t negateMask(int64_t mask, int64_t maxMask) {
 	return (~mask) & maxMask;
 }
 
+// The valves left after RemoveVerticesHardIf, numbered 0..n-1 in the order of the mask bits, with their
+// flows and pairwise distances in dense arrays for the table loops.
+struct CompactValves {
+	std::vector<int> Ids;
+	std::vector<int> Flows;
+	// [FROM * COUNT + TO]
+	std::vector<int> Distances;
+
+	int GetCount() const noexcept {
+		return int(Ids.size());
+	}
+};
+
+// [TIME][ACTIVE MASK][VERTEX] -> FLOW in one buffer, a time layer after the other. TFlow is as narrow as
+// the largest possible flow allows, which halves the table for the usual inputs.
+template<typename TFlow>
+class LookUpTable {
+public:
+	LookUpTable(int maxTime, int nVertices) :
+		MaxTime(maxTime), NVertices(nVertices), LayerSize(std::size_t(getMaxMask(nVertices) + 1) * std::size_t(nVertices)),
+		Cells(std::size_t(maxTime + 1) * LayerSize)
+	{
+	}
+
+	int GetMaxTime() const noexcept { return MaxTime; }
+	int GetVertexCount() const noexcept { return NVertices; }
+
+	TFlow& operator()(int time, int64_t mask, int vertex) noexcept {
+		return Cells[IndexOf(time, mask, vertex)];
+	}
+
+	TFlow operator()(int time, int64_t mask, int vertex) const noexcept {
+		return Cells[IndexOf(time, mask, vertex)];
+	}
+
+	std::span<TFlow> Layer(int time) noexcept {
+		return Cells.Span(std::size_t(time) * LayerSize, LayerSize);
+	}
+
+	std::span<TFlow const> Layer(int time) const noexcept {
+		return Cells.Span(std::size_t(time) * LayerSize, LayerSize);
+	}
+
+private:
+	std::size_t IndexOf(int time, int64_t mask, int vertex) const noexcept {
+		return std::size_t(time) * LayerSize + std::size_t(mask) * std::size_t(NVertices) + std::size_t(vertex);
+	}
+
+	int MaxTime{};
+	int NVertices{};
+	std::size_t LayerSize{};
+	aoc::PageArray<TFlow> Cells;
+};
+
 class Graph {
 	static int inf;
+	static constexpr int tileSize = 32;
 public:
-	Graph(std::vector<Valve> const& valves) noexcept {
-		Valves.reserve(valves.size());
-
+	// valve ids are dense, one per line of the input
+	Graph(std::vector<Valve> const& valves) : Distances(int(valves.size()), int(valves.size()), inf), Valves(valves.size()) {
 		for(auto const& valve : valves) {
 			int const valveId = valve.id;
-			Valves.emplace(valveId, valve);
 
-			for(auto const& valve2 : valves) {
-				Neighbors[valveId].emplace(valve2.id, inf);
+			[[unlikely]]
+			if(valveId >= int(valves.size())) {
+				aoc::crash("Valve " + std::to_string(valveId) + " is a tunnel target without a line of its own");
 			}
 
+			Valves[valveId] = valve;
+
+			Distances(valveId, valveId) = 0;
+
 			for(auto const& neighbor : valve.neighbors) {
-				Neighbors[valveId][neighbor] = 1;
+				[[unlikely]]
+				if(neighbor >= int(valves.size())) {
+					aoc::crash("Valve " + std::to_string(neighbor) + " is a tunnel target without a line of its own");
+				}
+
+				Distances(neighbor, valveId) = 1;
 			}
 		}
 	}
 
+	// Floyd-Warshall over the dense matrix in square tiles: the pivot tile first, then the tiles in its
+	// row and column, then all the others, so each pass over k only touches three tiles at a time.
 	void MakeShortestPaths() {
-		for(auto const& [source, _] : Valves) {
-			for(int i = 0; i < int(Valves.size()); ++i) {
-				for(auto& [v1, neighbors] : Neighbors) {
-					for(auto& [v2, distance] : neighbors) {
+		AOC_SCOPED_TIMER("day16.shortest_paths");
+
+		int const n = Distances.GetWidth();
+
+		auto const relaxTile = [this, n](int kTile, int iTile, int jTile) {
+			int const kEnd = std::min(kTile + tileSize, n);
+			int const iEnd = std::min(iTile + tileSize, n);
+			int const jEnd = std::min(jTile + tileSize, n);
+
+			for(int k = kTile; k < kEnd; ++k) {
+				int const* const fromK = Distances.Row(k).data();
 
-						int const distanceToV1 = Neighbors[source][v1];
-						int& distanceToV2 = Neighbors[source][v2];
+				for(int i = iTile; i < iEnd; ++i) {
+					int* const fromI = Distances.Row(i).data();
+					int const throughK = fromI[k];
 
-						distanceToV2 = std::min(distanceToV2, distanceToV1 + distance);
+					for(int j = jTile; j < jEnd; ++j) {
+						fromI[j] = std::min(fromI[j], throughK + fromK[j]);
 					}
 				}
 			}
-		}
+		};
+
+		for(int kTile = 0; kTile < n; kTile += tileSize) {
+			relaxTile(kTile, kTile, kTile);
+
+			for(int tile = 0; tile < n; tile += tileSize) {
+				if(tile != kTile) {
+					relaxTile(kTile, kTile, tile);
+					relaxTile(kTile, tile, kTile);
+				}
+			}
 
-		for(auto& [source, neighbors] : Neighbors) {
-			neighbors.erase(source);
+			for(int iTile = 0; iTile < n; iTile += tileSize) {
+				for(int jTile = 0; jTile < n; jTile += tileSize) {
+					if(iTile != kTile && jTile != kTile) {
+						relaxTile(kTile, iTile, jTile);
+					}
+				}
+			}
 		}
 	}
 
 	void RemoveVerticesHardIf(auto const& pred) {
-		for(auto& [id, valve] : Valves) {
+		for(auto const& valve : Valves) {
 			if(pred(valve)) {
-				RemoveVertex(id);
+				RemoveVertex(valve.id);
 			}
 		}
 	}
 
-	// [TIME][ACTIVE MASK][VERTEX] -> FLOW
-	std::vector<std::vector<std::vector<int>>> MakeLookUpTable(int maxTime) const {
-		std::vector<int> vertexMap;
+	CompactValves GetCompactValves() const {
+		CompactValves compact;
 
-		for(auto const& [id, valve] : Valves) {
+		for(auto const& valve : Valves) {
 			if(!valve.deleted) {
-				vertexMap.emplace_back(id);
+				compact.Ids.emplace_back(valve.id);
+				compact.Flows.emplace_back(valve.flow);
 			}
 		}
 
-		int const nVertices = int(vertexMap.size());
+		int const count = compact.GetCount();
+		compact.Distances.resize(std::size_t(count) * std::size_t(count));
 
-		std::vector<std::vector<std::vector<int>>> lookUpTable(
-			maxTime + 1, std::vector<std::vector<int>>(
-				getMaxMask(nVertices) + 1LL, std::vector<int>(
-					nVertices, 0
-				)
-			)
-		);
+		for(int from = 0; from < count; ++from) {
+			for(int to = 0; to < count; ++to) {
+				compact.Distances[std::size_t(from) * std::size_t(count) + std::size_t(to)] = GetDistance(compact.Ids[from], compact.Ids[to]);
+			}
+		}
 
-		for(int time = 1; time <= maxTime; ++time) {
-			
-#pragma omp parallel for
-			for(int64_t mask = 0; mask <= getMaxMask(nVertices); ++mask) {
-				
-				for(int source = 0; source < nVertices; ++source) {
+		return compact;
+	}
 
-					int const mappedSource = vertexMap[source];
-					auto const sourceFlow = Valves.at(mappedSource).flow;
-					int const myFlow = (time - 1) * sourceFlow;
-					int bestExtraFlow = 0;
+	// Upper bound of any entry of a table up to maxTime, every valve opened right away.
+	int GetFlowBound(int maxTime) const {
+		int totalFlow = 0;
+
+		for(auto const& valve : Valves) {
+			if(!valve.deleted) {
+				totalFlow += valve.flow;
+			}
+		}
+
+		return std::max(0, maxTime - 1) * totalFlow;
+	}
+
+	// Each finished time layer is checkpointed; a restarted run loads the layers it already has and
+	// continues with the first missing one.
+	template<typename TFlow>
+	LookUpTable<TFlow> MakeLookUpTable(int maxTime, aoc::Checkpoint const& checkpoint) const {
+		AOC_SCOPED_TIMER("day16.lookup_table");
+
+		[[unlikely]]
+		if(GetFlowBound(maxTime) > std::numeric_limits<TFlow>::max()) {
+			aoc::crash("The flow of this cave does not fit the lookup table");
+		}
+
+		auto const compact = GetCompactValves();
+		int const nVertices = compact.GetCount();
+		auto const maxMask = getMaxMask(nVertices);
+
+		LookUpTable<TFlow> lookUpTable(maxTime, nVertices);
+
+		// a layer is the same whatever the horizon, so any later table can pick it up
+		auto const layerRecord = [](int time) {
+			return "table-layer" + std::to_string(time);
+		};
+
+		int firstTime = 1;
+
+		while(firstTime <= maxTime && checkpoint.Load(layerRecord(firstTime), lookUpTable.Layer(firstTime))) {
+			++firstTime;
+		}
+
+		for(int time = firstTime; time <= maxTime; ++time) {
+			AOC_COUNT_ADD("day16.masks_evaluated", maxMask + 1);
+
+			// every mask of this layer only reads the earlier layers
+			aoc::parallelFor(0, maxMask + 1, [&](int64_t mask) {
+
+				// an entry whose source is already open is never read, so only the closed valves are sources
+				for(auto sources = uint64_t(negateMask(mask, maxMask)); sources != 0; sources &= sources - 1) {
+					int const source = std::countr_zero(sources);
+					int const* const fromSource = compact.Distances.data() + std::size_t(source) * std::size_t(nVertices);
 					auto const newMask = setBit(source, mask);
-				
-					for(int neighbor = 0; neighbor < nVertices; ++neighbor) {
-						
-						// also skips if neighbor == source
-						if(isBitSet(neighbor, newMask)) {
-							continue;
-						}
 
-						int const mappedNeighbor = vertexMap[neighbor];
-						int const distance = Neighbors.at(mappedSource).at(mappedNeighbor);
+					int bestExtraFlow = 0;
+
+					for(auto neighbors = uint64_t(negateMask(newMask, maxMask)); neighbors != 0; neighbors &= neighbors - 1) {
+						int const neighbor = std::countr_zero(neighbors);
+						int const timeLeft = time - fromSource[neighbor] - 1;
 
-						if(time - distance < 1) {
+						if(timeLeft < 0) {
 							continue;
 						}
 
-						bestExtraFlow = std::max(bestExtraFlow, lookUpTable[time - distance - 1][newMask][neighbor]);
-
+						bestExtraFlow = std::max(bestExtraFlow, int(lookUpTable(timeLeft, newMask, neighbor)));
 					}
 
-					lookUpTable[time][mask][source] = myFlow + bestExtraFlow;
-
+					lookUpTable(time, mask, source) = TFlow((time - 1) * compact.Flows[source] + bestExtraFlow);
 				}
 
-			} // end of parallel for
+			});
+
+			checkpoint.Save(layerRecord(time), std::as_const(lookUpTable).Layer(time));
 
 		}
 
 		return lookUpTable;
 	}
 
+	// the distances through a removed valve stay valid, only the valve itself is skipped from now on
 	void RemoveVertex(int id) {
 		Valves[id].deleted = true;
-
-		for(auto& [neighbor, distance] : Neighbors[id]) {
-			if(Neighbors[neighbor].count(id) > 0) {
-				Neighbors[neighbor].erase(id);
-			}
-		}
 	}
 
-	std::unordered_map<int, Valve> const& GetValves() const {
+	std::vector<Valve> const& GetValves() const {
 		return Valves;
 	}
 
-	auto const& GetNeighbors() const {
-		return Neighbors;
+	int GetDistance(int from, int to) const noexcept {
+		return Distances(to, from);
 	}
 
 private:
-	std::unordered_map<int, std::unordered_map<int, int>> Neighbors;
-	std::unordered_map<int, Valve> Valves;
+	// Distances(to, from), so every row holds the distances from one valve
+	aoc::Grid2D<int> Distances;
+	// indexed by the interned id
+	std::vector<Valve> Valves;
 };
 
 
 int Graph::inf = 9999;
 
-int main() {
-	
-	auto lines = readLines("input.txt");
+// Best flow a single agent gets from AA within time when it may only open the valves of the mask, for
+// every mask. The table entry for the complement already is the best over all subsets of the mask, so the
+// result is monotone: a mask is never worse than any of its subsets.
+template<typename TFlow>
+std::vector<int> bestFlowPerMask(LookUpTable<TFlow> const& lookUpTable, std::vector<int> const& startDistances, int time) {
+	AOC_SCOPED_TIMER("day16.best_per_mask");
 
-	auto parsedValves = parseLines(lines);
+	auto const maxMask = getMaxMask(lookUpTable.GetVertexCount());
 
-	Graph graph(parsedValves);
+	std::vector<int> bestFlows(maxMask + 1, 0);
 
-	graph.MakeShortestPaths();
+	aoc::parallelFor(0, maxMask + 1, [&](int64_t mask) {
+		auto const closedMask = negateMask(mask, maxMask);
 
-	graph.RemoveVerticesHardIf([](Valve const& valve) -> bool {return valve.flow == 0; });
+		int best = 0;
+
+		for(auto remaining = uint64_t(mask); remaining != 0; remaining &= remaining - 1) {
+			int const start = std::countr_zero(remaining);
+			int const timeLeft = time - startDistances[start];
+
+			// too far away to be opened in time
+			if(timeLeft < 1) {
+				continue;
+			}
+
+			best = std::max(best, int(lookUpTable(timeLeft, closedMask, start)));
+		}
+
+		bestFlows[mask] = best;
+	});
 
-	auto const& valves = graph.GetValves();
-	auto const& aasNeighbors = graph.GetNeighbors().at(getVertexId("AA"));
+	return bestFlows;
+}
+
+// Best flow of a group of agents for every mask, given the best of one agent less and of a single agent:
+// the group's valves are split between the smaller group and the new agent in every possible way, O(3^n).
+std::vector<int> addAgent(std::vector<int> const& groupFlows, std::vector<int> const& singleFlows) {
+	AOC_SCOPED_TIMER("day16.add_agent");
 
-	auto lookUpTable1 = graph.MakeLookUpTable(30);
+	std::vector<int> bestFlows(groupFlows.size(), 0);
 
-	int result1 = 0;
+	aoc::parallelFor(0, (long long)(groupFlows.size()), [&](int64_t mask) {
+		int best = groupFlows[mask];
 
-	for(int mappedId = 0;  auto const& [id, valve] : valves) {
-		if(valve.deleted) {
-			continue;
+		for(int64_t groupMask = mask; groupMask != 0; groupMask = (groupMask - 1) & mask) {
+			best = std::max(best, groupFlows[groupMask] + singleFlows[mask ^ groupMask]);
 		}
 
-		int const distance = aasNeighbors.at(valve.id);
+		bestFlows[mask] = best;
+	});
+
+	return bestFlows;
+}
 
-		result1 = std::max(result1, lookUpTable1[30 - distance][0][mappedId]);
+// Answers any horizon up to the one the table was built for, for any number of agents starting together at
+// the same valve, all from the same table: a layer for some time left does not depend on the horizon.
+template<typename TFlow>
+class FlowPlanner {
+public:
+	FlowPlanner(Graph const& graph, int startId, int maxTime, aoc::Checkpoint const& checkpoint) :
+		Table(graph.MakeLookUpTable<TFlow>(maxTime, checkpoint))
+	{
+		for(auto const id : graph.GetCompactValves().Ids) {
+			StartDistances.emplace_back(graph.GetDistance(startId, id));
+		}
+	}
 
-		++mappedId;
+	int GetMaxTime() const noexcept {
+		return Table.GetMaxTime();
 	}
 
-	std::cout << result1 << '\n';
+	int GetBestFlow(int time, int agents) const {
+		[[unlikely]]
+		if(time < 0 || time > GetMaxTime() || agents < 1) {
+			aoc::crash("Cannot plan " + std::to_string(agents) + " agents for " + std::to_string(time) + " minutes with a table of " + std::to_string(GetMaxTime()) + " minutes");
+		}
+
+		auto const maxMask = getMaxMask(Table.GetVertexCount());
+		auto const singleFlows = bestFlowPerMask(Table, StartDistances, time);
+
+		if(agents == 1) {
+			return singleFlows[maxMask];
+		}
 
-	int nValves = 0;
+		auto groupFlows = singleFlows;
 
-	for(auto const& [id, valve] : valves) {
-		if(!valve.deleted) {
-			++nValves;
+		for(int agent = 2; agent < agents; ++agent) {
+			groupFlows = addAgent(groupFlows, singleFlows);
 		}
+
+		aoc::enterPhase(aoc::Phase::Combine);
+
+		// only the last agent's share is needed for the whole set; with two agents the masks without the
+		// highest valve already cover every split once
+		auto const nMasks = agents == 2 ? (maxMask >> 1) + 1 : maxMask + 1;
+
+		return aoc::parallelReduce(0, nMasks, 0, [&](int& best, int64_t mask) {
+			best = std::max(best, groupFlows[mask] + singleFlows[negateMask(mask, maxMask)]);
+		}, [](int left, int right) { return std::max(left, right); });
 	}
 
-	int result2 = 0;
+private:
+	LookUpTable<TFlow> Table;
+	std::vector<int> StartDistances;
+};
 
-	auto lookUpTable2 = graph.MakeLookUpTable(26);
+// The most valves with flow any cave may have: one bit each in the search's masks. Inputs with more are
+// rejected right after parsing; the generator never writes them.
+constexpr int searchValveLimit = 64;
+
+// Branch and bound over the reachable (position, time, open valves) states instead of a table over all
+// 2^n masks, for caves with too many valves for one. A single agent prunes against the best flow so far;
+// several agents first record the best flow of every exact set of opened valves one agent reaches, then
+// pick disjoint sets, best first. Those recordings are pruned against a plan the agents surely reach: the
+// best single agent, and each further one on the valves the others left closed.
+// The opened valves are one 64-bit mask, so the cave has at most searchValveLimit valves with flow.
+class FlowSearch {
+public:
+	FlowSearch(Graph const& graph, int startId) : Valves(graph.GetCompactValves()) {
+		int const nValves = Valves.GetCount();
 
-	auto const maxMask = getMaxMask(nValves);
+		int minDistance = std::numeric_limits<int>::max();
 
-#pragma omp parallel for
-	for(int64_t mask = 0; mask <= maxMask; ++mask) {
+		for(auto const id : Valves.Ids) {
+			StartDistances.emplace_back(graph.GetDistance(startId, id));
+			minDistance = std::min(minDistance, StartDistances.back());
+		}
 
-		auto const negatedMask = negateMask(mask, maxMask);
-		
-		for(int mappedNeighbor1id = 0; auto const& [id1, valve1] : valves) {
-			if(valve1.deleted) {
-				continue;
+		for(int from = 0; from < nValves; ++from) {
+			for(int to = 0; to < nValves; ++to) {
+				if(from != to) {
+					minDistance = std::min(minDistance, Valves.Distances[std::size_t(from) * std::size_t(nValves) + std::size_t(to)]);
+				}
 			}
+		}
 
-			if(!isBitSet(mappedNeighbor1id, mask)) {
+		// walking to the next valve and opening it takes at least this long
+		MinStep = minDistance + 1;
 
-				int const distance1 = aasNeighbors.at(valve1.id);
+		ByFlow.resize(nValves);
+		std::iota(ByFlow.begin(), ByFlow.end(), 0);
+		std::ranges::sort(ByFlow, std::greater{}, [this](int valve) { return Valves.Flows[valve]; });
+	}
 
-				int const result2_me = lookUpTable2[26 - distance1][mask][mappedNeighbor1id];
+	int GetBestFlow(int time, int agents) const {
+		AOC_SCOPED_TIMER("day16.search");
 
-				for(int mappedNeighbor2id = 0; auto const& [id2, valve2] : valves) {
-					if(valve2.deleted) {
-						continue;
-					}
+		[[unlikely]]
+		if(time < 0 || agents < 1) {
+			aoc::crash("Cannot plan " + std::to_string(agents) + " agents for " + std::to_string(time) + " minutes");
+		}
 
-					if(!isBitSet(mappedNeighbor2id, negatedMask)) {
+		Search single{ .Time = time };
+		Explore(single, -1, time, 0, 0);
 
-						int const distance2 = aasNeighbors.at(valve2.id);
+		if(agents == 1) {
+			return single.Best;
+		}
 
-						int const result2_elephant = lookUpTable2[26 - distance2][negatedMask][mappedNeighbor2id];
+		// a plan that is always possible: every further agent takes the best of what the others left closed
+		int lowerBound = single.Best;
+		uint64_t takenMask = single.BestMask;
 
-#pragma omp critical
-						result2 = std::max(result2, result2_me + result2_elephant);
+		for(int agent = 1; agent < agents; ++agent) {
+			Search next{ .Time = time };
+			Explore(next, -1, time, takenMask, 0);
 
-					}
+			lowerBound += next.Best;
+			takenMask |= next.BestMask;
+		}
+
+		// with a fixed bound the first valves are independent searches, one task each, merged afterwards
+		std::vector<Search> recordings(Valves.GetCount());
 
-					++mappedNeighbor2id;
+		aoc::parallelFor(0, (long long)(recordings.size()), [&](long long first) {
+			auto& recording = recordings[first];
+			recording = Search{ .Time = time, .OtherAgents = agents - 1, .Best = lowerBound, .SingleBest = single.Best, .IsRecording = true };
+
+			Visit(recording, -1, time, 0, 0, int(first));
+		}, 1);
+
+		aoc::FlatMap<uint64_t, int> bestPerMask;
+		bestPerMask.Insert(0, 0);
+
+		for(auto const& recording : recordings) {
+			recording.BestPerMask.ForEach([&bestPerMask](uint64_t mask, int flow) {
+				auto const [best, isInserted] = bestPerMask.Insert(mask, flow);
+				*best = std::max(*best, flow);
+			});
+		}
+
+		std::vector<std::pair<int, uint64_t>> sets;
+		sets.reserve(bestPerMask.GetSize());
+
+		bestPerMask.ForEach([&sets](uint64_t mask, int flow) {
+			sets.emplace_back(flow, mask);
+		});
+
+		std::ranges::sort(sets, std::greater{});
+
+		aoc::enterPhase(aoc::Phase::Combine);
+
+		int best = lowerBound;
+		PickDisjoint(sets, 0, 0, agents, 0, best);
+
+		return best;
+	}
+
+private:
+	struct Search {
+		int Time{};
+		int OtherAgents{};
+		// the best complete flow so far, or when recording what the agents surely reach together
+		int Best{};
+		// when recording, what one agent reaches alone
+		int SingleBest{};
+		uint64_t BestMask{};
+		bool IsRecording{};
+		aoc::FlatMap<uint64_t, int> BestPerMask{};
+	};
+
+	// No more than every closed valve opened as early as possible, the biggest flows first, each by whichever
+	// agent has the most time left at that point: this one from timeLeft, the others still from the start.
+	int GetOptimisticFlow(int timeLeft, int otherAgents, int otherTimeLeft, uint64_t openMask) const noexcept {
+		int flow = 0;
+
+		timeLeft -= MinStep;
+		otherTimeLeft -= MinStep;
+
+		int othersAtThisTime = otherAgents;
+
+		for(auto const valve : ByFlow) {
+			if(isBitSet(valve, int64_t(openMask))) {
+				continue;
+			}
+
+			if(othersAtThisTime > 0 && otherTimeLeft > timeLeft) {
+				if(otherTimeLeft <= 0) {
+					break;
+				}
+
+				flow += otherTimeLeft * Valves.Flows[valve];
+
+				if(--othersAtThisTime == 0) {
+					otherTimeLeft -= MinStep;
+					othersAtThisTime = otherAgents;
 				}
 			}
+			else {
+				if(timeLeft <= 0) {
+					break;
+				}
+
+				flow += timeLeft * Valves.Flows[valve];
+				timeLeft -= MinStep;
+			}
+		}
+
+		return flow;
+	}
+
+	void Explore(Search& search, int position, int timeLeft, uint64_t openMask, int flow) const {
+		AOC_COUNT("day16.search_states");
+
+		for(auto closed = ~openMask & uint64_t(getMaxMask(Valves.GetCount())); closed != 0; closed &= closed - 1) {
+			Visit(search, position, timeLeft, openMask, flow, std::countr_zero(closed));
+		}
+	}
+
+	// Walks to the valve, opens it and explores from there, unless that cannot pay off.
+	void Visit(Search& search, int position, int timeLeft, uint64_t openMask, int flow, int valve) const {
+		int const nValves = Valves.GetCount();
+		int const distance = position < 0 ? StartDistances[valve] : Valves.Distances[std::size_t(position) * std::size_t(nValves) + std::size_t(valve)];
+		int const valveTimeLeft = timeLeft - distance - 1;
+
+		if(valveTimeLeft <= 0) {
+			return;
+		}
+
+		auto const valveMask = uint64_t(setBit(valve, int64_t(openMask)));
+		int const valveFlow = flow + valveTimeLeft * Valves.Flows[valve];
+
+		int bound = valveFlow + GetOptimisticFlow(valveTimeLeft, 0, 0, valveMask);
+
+		// the other agents' sets are disjoint from this one, so they only share the valves still closed, and
+		// none of them gets more than a single agent on its own
+		if(search.OtherAgents > 0) {
+			bound = std::min(
+				valveFlow + GetOptimisticFlow(valveTimeLeft, search.OtherAgents, search.Time, valveMask),
+				bound + search.OtherAgents * search.SingleBest
+			);
+		}
+
+		if(bound <= search.Best) {
+			return;
+		}
+
+		if(search.IsRecording) {
+			auto const [best, isInserted] = search.BestPerMask.Insert(valveMask, valveFlow);
+			*best = std::max(*best, valveFlow);
+		}
+		else if(valveFlow > search.Best) {
+			search.Best = valveFlow;
+			search.BestMask = valveMask;
+		}
+
+		Explore(search, valve, valveTimeLeft, valveMask, valveFlow);
+	}
+
+	// Sets are sorted by flow, so once the rest cannot beat the best even at the current set's flow, no
+	// later set can either.
+	static void PickDisjoint(std::vector<std::pair<int, uint64_t>> const& sets, std::size_t first, uint64_t usedMask, int agentsLeft, int flow, int& best) {
+		best = std::max(best, flow);
+
+		if(agentsLeft == 0) {
+			return;
+		}
+
+		for(std::size_t idx = first; idx < sets.size(); ++idx) {
+			auto const [setFlow, mask] = sets[idx];
+
+			if(flow + agentsLeft * setFlow <= best) {
+				break;
+			}
 
-			++mappedNeighbor1id;
+			if((mask & usedMask) == 0) {
+				PickDisjoint(sets, idx + 1, usedMask | mask, agentsLeft - 1, flow + setFlow, best);
+			}
 		}
+	}
+
+	CompactValves Valves;
+	std::vector<int> StartDistances;
+	std::vector<int> ByFlow;
+	int MinStep{};
+};
+
+// Up to this many valves with flow a table over every mask is built, about 65 MB at 16 valves and
+// 30 minutes; beyond it the reachable states are searched instead.
+constexpr int tableValveLimit = 16;
+
+// both parts from the same planner
+template<typename TPlanner>
+aoc::Answers solvePlanner(TPlanner const& planner) {
+	return { .Part1 = planner.GetBestFlow(30, 1), .Part2 = planner.GetBestFlow(26, 2) };
+}
+
+aoc::Answers solve(std::string_view input) {
+	
+	auto const lines = aoc::splitLines(input);
+
+	VertexIds vertexIds;
+
+	auto parsedValves = parseLines(lines, vertexIds);
+
+	auto const nFlowValves = std::ranges::count_if(parsedValves, [](Valve const& valve) { return valve.flow > 0; });
 
+	[[unlikely]]
+	if(nFlowValves > searchValveLimit) {
+		aoc::crash("The cave has " + std::to_string(nFlowValves) + " valves with flow, at most " + std::to_string(searchValveLimit) + " are supported");
+	}
+
+	aoc::markParsed();
+
+	aoc::Checkpoint const checkpoint("16ab", solverVersion, input);
+
+	Graph graph(parsedValves);
+
+	graph.MakeShortestPaths();
+
+	graph.RemoveVerticesHardIf([](Valve const& valve) -> bool {return valve.flow == 0; });
+
+	int const aaId = vertexIds.FindVertexId("AA");
+
+	[[unlikely]]
+	if(aaId < 0) {
+		aoc::crash("The cave has no valve AA to start from");
+	}
+
+	aoc::Answers answers;
+
+	// one table up to 30 minutes serves both parts
+	if(graph.GetCompactValves().GetCount() > tableValveLimit) {
+		answers = solvePlanner(FlowSearch(graph, aaId));
+	}
+	else if(graph.GetFlowBound(30) <= std::numeric_limits<uint16_t>::max()) {
+		answers = solvePlanner(FlowPlanner<uint16_t>(graph, aaId, 30, checkpoint));
 	}
+	else {
+		answers = solvePlanner(FlowPlanner<int>(graph, aaId, 30, checkpoint));
+	}
+
+	checkpoint.Discard();
 
-	std::cout << result2 << '\n';
+	return answers;
+
+}
+
+}
+
+#ifndef AOC_DRIVER
+int main() {
+	
+	aoc::PuzzleInput input("input.txt");
+
+	auto const answers = Day16ab::solve(input.Data());
+
+	std::cout << aoc::toString(answers.Part1) << '\n';
+
+	std::cout << aoc::toString(answers.Part2) << '\n';
 
 	return 0;
 
-}
\ No newline at end of file
+}
+#endif
\ No newline at end of file
@@ -1,33 +1,29 @@
-#include <fstream>
+#include <array>
 #include <iostream>
 #include <numeric>
 #include <string>
-#include <unordered_map>
 #include <vector>
 
-void crash(std::string const& message) {
-	std::cerr << message << std::endl;
-	std::terminate();
-}
+#include "../../Common/crash.h"
+#include "../../Common/hashmap.h"
+#include "../../Common/input.h"
+#include "../../Common/log.h"
+#include "../../Common/metrics.h"
+#include "../../Common/solver.h"
 
-std::string readInput(std::string const& file) {
-	std::ifstream input(file);
+namespace Day17ab {
 
-	[[unlikely]]
-	if(!input.is_open()) {
-		crash("Could not open the input file.");
-	}
+using aoc::crash;
 
-	std::string directions;
+std::string_view readInput(std::string_view input) {
+	auto const lines = aoc::splitLines(input);
 
 	[[unlikely]]
-	if(!std::getline(input, directions)) {
+	if(lines.empty()) {
 		crash("Could not read input.");
 	}
 
-	input.close();
-
-	return directions;
+	return lines.front();
 }
 
 enum class FieldType : char {
@@ -39,7 +35,7 @@ struct Shape {
 
 	Shape() noexcept = default;
 
-	Shape(std::vector<FieldType>&& buffer, int width, int height) noexcept :
+	Shape(std::vector<FieldType>&& buffer, int width, int height) :
 		Width(width),
 		Height(height),
 		Buffer(buffer)
@@ -64,10 +60,18 @@ struct Shape {
 
 struct Cave : public Shape {
 
-	Cave(int width) noexcept :
+	// The cache keys hold one height per column in a fixed array.
+	static constexpr int maxWidth = 8;
+
+	Cave(int width) :
 		Shape({}, width, 0),
 		Ys(width, -1)
 	{
+		[[unlikely]]
+		if(width > maxWidth) {
+			crash("The cave is too wide");
+		}
+
 		EmptyRow = std::vector(width, FieldType::Air);
 	}
 
@@ -144,10 +148,11 @@ struct Cave : public Shape {
 
 	}
 
-	std::vector<int> GetRelativeYsView() const noexcept {
-		std::vector<int> ret(Ys);
-		for(auto& y : ret) {
-			y -= HighestRockY;
+	// Columns past the width stay 0.
+	std::array<int, maxWidth> GetRelativeYsView() const noexcept {
+		std::array<int, maxWidth> ret{};
+		for(int x = 0; x < Width; ++x) {
+			ret[x] = Ys[x] - HighestRockY;
 		}
 		return ret;
 	}
@@ -155,29 +160,16 @@ struct Cave : public Shape {
 	struct CacheElement {
 		int shapeIdx;
 		int directionIdx;
-		std::vector<int> ysView;
+		std::array<int, maxWidth> ysView;
 
 		bool operator==(CacheElement const&) const noexcept = default;
 	};
 
-	struct CacheElementHash {
-
-		size_t operator()(CacheElement const& element) const noexcept {
-			static std::hash<int> hashInt{};
-			size_t hash = hashInt(element.directionIdx) ^ hashInt(element.shapeIdx);
-
-			for(auto const& y : element.ysView) {
-				hash ^= hashInt(y);
-			}
-			return hash;
-		}
-
-	};
-
 	template<bool isTerminatedOnCacheHit>
-	int Simulate(std::vector<Shape> const& shapes, std::string const& directions, int steps) {
+	int Simulate(std::vector<Shape> const& shapes, std::string_view directions, int steps) {
+		AOC_SCOPED_TIMER("day17.simulate");
 
-		std::unordered_map<CacheElement, int, CacheElementHash> cache;
+		aoc::FlatMap<CacheElement, int> cache;
 
 		int shapeIdx = 0;
 		int directionIdx = 0;
@@ -223,11 +215,14 @@ struct Cave : public Shape {
 			if constexpr(isTerminatedOnCacheHit) {
 
 				auto relativeYsView = GetRelativeYsView();
+
+				AOC_COUNT("day17.cache_probes");
 					
 				auto& previousStep = cache[CacheElement{ .shapeIdx = shapeIdx, .directionIdx = directionIdx, .ysView = relativeYsView }];
 
 				if(previousStep != 0) {
-					std::cout << "Cache hit!\n";
+					AOC_COUNT("day17.cache_hits");
+					AOC_DEBUG("Cache hit!\n");
 					return previousStep;
 				}
 				else {
@@ -247,10 +242,10 @@ struct Cave : public Shape {
 		for(int y = Height - 1; y > Height - 1 - lines; --y) {
 
 			for(int x = 0; x < Width; ++x) {
-				std::cout << std::to_underlying(operator()(x, y));
+				aoc::logOutput() << std::to_underlying(operator()(x, y));
 			}
 
-			std::cout << '\n';
+			aoc::logOutput() << '\n';
 		}
 	}
 
@@ -262,9 +257,11 @@ struct Cave : public Shape {
 	std::vector<int> Ys;
 };
 
-int main() {
+aoc::Answers solve(std::string_view input) {
+
+	std::string_view directions = readInput(input);
 
-	std::string directions = readInput("input.txt");
+	aoc::markParsed();
 
 	FieldType air = FieldType::Air;
 	FieldType stone = FieldType::SolidStone;
@@ -281,7 +278,7 @@ int main() {
 
 	cave.Simulate<false>(shapes, directions, 2022);
 
-	std::cout << (1 + cave.HighestRockY) << std::endl;
+	long long const height1 = 1 + cave.HighestRockY;
 
 	Cave cave2(7);
 
@@ -310,7 +307,22 @@ int main() {
 
 	long long const extraHeight = heightExtra - heightFrom;
 
-	std::cout << (1LL + heightFrom + baseHeight + extraHeight) << std::endl;
+	return { .Part1 = height1, .Part2 = 1LL + heightFrom + baseHeight + extraHeight };
+}
+
+}
+
+#ifndef AOC_DRIVER
+int main() {
+
+	aoc::PuzzleInput input("input.txt");
+
+	auto const answers = Day17ab::solve(input.Data());
+
+	std::cout << aoc::toString(answers.Part1) << std::endl;
+
+	std::cout << aoc::toString(answers.Part2) << std::endl;
 
 	return 0;
-}
\ No newline at end of file
+}
+#endif
\ No newline at end of file
@@ -1,6 +1,4 @@
 #include <array>
-#include <charconv>
-#include <fstream>
 #include <iostream>
 #include <ranges>
 #include <stack>
@@ -8,33 +6,15 @@
 #include <tuple>
 #include <vector>
 
-void crash(std::string const& message) {
-	std::cerr << message << std::endl;
-	std::terminate();
-}
-
-std::vector<std::string> readLines(std::string const& file) {
-	std::ifstream input(file);
-
-	[[unlikely]]
-	if(!input.is_open()) {
-		crash("Could not open the input file!");
-	}
-
-	std::vector<std::string> lines;
+#include "../../Common/crash.h"
+#include "../../Common/grid.h"
+#include "../../Common/input.h"
+#include "../../Common/numbers.h"
+#include "../../Common/solver.h"
 
-	{
-		std::string line;
+namespace Day18ab {
 
-		while(std::getline(input, line)) {
-			lines.emplace_back(line);
-		}
-	}
-
-	input.close();
-
-	return lines;
-}
+using aoc::crash;
 
 using vec3 = std::tuple<int, int, int>;
 
@@ -47,23 +27,12 @@ static constexpr std::array<vec3, 6> lookAround{ {
 	{0, 0, 1}
 } };
 
-int strToInt(std::string_view str) {
-
-	[[likely]]
-	if(int result; std::from_chars(str.data(), str.data() + str.length(), result).ec == std::errc{}) {
-		return result;
-	}
-
-	crash("Could not parse int " + std::string(str));
-	return 0;
-}
-
-std::vector<vec3> parseCubes(std::vector<std::string> const& input) {
+std::vector<vec3> parseCubes(std::vector<std::string_view> const& input) {
 	auto cubesRange = input | 
 		std::views::transform([](auto const& cubeString) {
 			auto parsedInts = cubeString |
 				std::views::split(std::string_view(",")) |
-				std::views::transform([](auto const& rawIntRange){return strToInt(std::string_view(rawIntRange.begin(), rawIntRange.end()));});
+				std::views::transform([](auto const& rawIntRange){return aoc::parseInt(std::string_view(rawIntRange.begin(), rawIntRange.end()));});
 
 			[[unlikely]]
 			if(std::ranges::distance(parsedInts) != 3) {
@@ -110,6 +79,8 @@ void forEach(vec3& vector, Functor transform) {
 	z = transform(z);
 }
 
+// The grids carry a one voxel border so the neighbour loops need no bounds checks: it holds no cubes,
+// and the flood fill sees it as already visited so it stays inside.
 struct VoxelGrid {
 
 	VoxelGrid(vec3 const& min, vec3 const& max) :
@@ -117,14 +88,13 @@ struct VoxelGrid {
 		Max(max),
 		SizeX(1 + std::get<0>(max) - std::get<0>(min)),
 		SizeY(1 + std::get<1>(max) - std::get<1>(min)),
-		SizeZ(1 + std::get<2>(max) - std::get<2>(min))
-	{
-		Cubes = std::vector<std::vector<std::vector<bool>>>(SizeZ, std::vector<std::vector<bool>>(SizeY, std::vector<bool>(SizeX)));
-		Neighbors = std::vector<std::vector<std::vector<int>>>(SizeZ, std::vector<std::vector<int>>(SizeY, std::vector<int>(SizeX)));
-	}
+		SizeZ(1 + std::get<2>(max) - std::get<2>(min)),
+		Cubes(SizeX, SizeY, SizeZ, false, 1),
+		Neighbors(SizeX, SizeY, SizeZ, 0, 1)
+	{}
 
 	void AddCubeAt(vec3 const& position) noexcept {
-		Cubes[std::get<2>(position) - std::get<2>(Min)][std::get<1>(position) - std::get<1>(Min)][std::get<0>(position) - std::get<0>(Min)] = true;
+		Cubes(std::get<0>(position) - std::get<0>(Min), std::get<1>(position) - std::get<1>(Min), std::get<2>(position) - std::get<2>(Min)) = true;
 	}
 
 	int CountNeighbors() noexcept {
@@ -135,21 +105,13 @@ struct VoxelGrid {
 				for(int x = 0; x < SizeX; ++x) {
 					
 					for(auto const& [dx, dy, dz] : lookAround) {
-						int const xx = x + dx;
-						int const yy = y + dy;
-						int const zz = z + dz;
-
-						if(xx < 0 || yy < 0 || zz < 0 || xx >= SizeX || yy >= SizeY || zz >= SizeZ) {
-							continue;
-						}
-
-						if(Cubes[zz][yy][xx]) {
+						if(Cubes(x + dx, y + dy, z + dz)) {
 
-							if(!Cubes[z][y][x]) {
+							if(!Cubes(x, y, z)) {
 								++count;
 							}
 
-							++Neighbors[z][y][x];
+							++Neighbors(x, y, z);
 						}
 					}
 
@@ -162,33 +124,29 @@ struct VoxelGrid {
 
 	int CountReachable() {
 
-		auto visited = std::vector<std::vector<std::vector<bool>>>(SizeZ, std::vector<std::vector<bool>>(SizeY, std::vector<bool>(SizeX)));
+		aoc::Grid3D<bool> visited(SizeX, SizeY, SizeZ, false, 1, true);
 
 		int count = 0;
 
 		std::stack<vec3> ss;
 
 		ss.emplace(0, 0, 0);
-		visited[0][0][0] = true;
+		visited(0, 0, 0) = true;
 
 		while(!ss.empty()) {
 			auto const [x, y, z] = ss.top();
 			ss.pop();
 
-			count += Neighbors[z][y][x];
+			count += Neighbors(x, y, z);
 
 			for(auto const& [dx, dy, dz] : lookAround) {
 				int const xx = x + dx;
 				int const yy = y + dy;
 				int const zz = z + dz;
 
-				if(xx < 0 || yy < 0 || zz < 0 || xx >= SizeX || yy >= SizeY || zz >= SizeZ) {
-					continue;
-				}
-
-				if(!Cubes[zz][yy][xx] && !visited[zz][yy][xx]) {
+				if(!Cubes(xx, yy, zz) && !visited(xx, yy, zz)) {
 
-					visited[zz][yy][xx] = true;
+					visited(xx, yy, zz) = true;
 
 					ss.emplace(xx, yy, zz);
 				}
@@ -198,19 +156,25 @@ struct VoxelGrid {
 		return count;
 	}
 
-	std::vector<std::vector<std::vector<bool>>> Cubes;
-	std::vector<std::vector<std::vector<int>>> Neighbors;
-
-
 	vec3 Min, Max;
 	int SizeX, SizeY, SizeZ;
+
+	aoc::Grid3D<bool> Cubes;
+	aoc::Grid3D<int> Neighbors;
 };
 
-int main() {
-	auto lines = readLines("input.txt");
+aoc::Answers solve(std::string_view input) {
+	auto const lines = aoc::splitLines(input);
 
 	auto cubes = parseCubes(lines);
 
+	aoc::markParsed();
+
+	[[unlikely]]
+	if(cubes.empty()) {
+		crash("There are no cubes");
+	}
+
 	vec3 min, max;
 
 	getExtremes(cubes, min, max);
@@ -226,11 +190,23 @@ int main() {
 
 	auto const surface = voxelGrid.CountNeighbors();
 
-	std::cout << surface << std::endl;
-
 	auto const reachableSurface = voxelGrid.CountReachable();
 
-	std::cout << reachableSurface << std::endl;
+	return { .Part1 = surface, .Part2 = reachableSurface };
+}
+
+}
+
+#ifndef AOC_DRIVER
+int main() {
+	aoc::PuzzleInput input("input.txt");
+
+	auto const answers = Day18ab::solve(input.Data());
+
+	std::cout << aoc::toString(answers.Part1) << std::endl;
+
+	std::cout << aoc::toString(answers.Part2) << std::endl;
 
 	return 0;
-}
\ No newline at end of file
+}
+#endif
\ No newline at end of file
@@ -1,39 +1,24 @@
-#include <charconv>
-#include <fstream>
+#include <algorithm>
 #include <iostream>
-#include <regex>
+#include <mutex>
+#include <span>
 #include <stack>
 #include <string>
-#include <unordered_set>
 #include <vector>
 
-void crash(std::string_view message) {
-	std::cerr << message << std::endl;
-	std::terminate();
-}
-
-std::vector<std::string> readLines(std::string const& file) {
-	std::ifstream input(file);
-
-	[[unlikely]]
-	if(!input.is_open()) {
-		crash("Could not open the input file!");
-	}
+#include "../../Common/checkpoint.h"
+#include "../../Common/hashmap.h"
+#include "../../Common/input.h"
+#include "../../Common/log.h"
+#include "../../Common/metrics.h"
+#include "../../Common/scanner.h"
+#include "../../Common/solver.h"
+#include "../../Common/tasks.h"
 
-	std::vector<std::string> lines;
+namespace Day19ab {
 
-	{
-		std::string line;
-
-		while(std::getline(input, line)) {
-			lines.emplace_back(line);
-		}
-	}
-
-	input.close();
-
-	return lines;
-}
+// Part of the result cache and checkpoint keys, see aoc::Solver::Version.
+constexpr int solverVersion = 1;
 
 struct Price {
 	int ores;
@@ -48,47 +33,24 @@ struct Blueprint {
 	Price geodeRobotCost;
 };
 
-int strToInt(std::string_view str) {
-	[[likely]]
-	if(int result; std::from_chars(str.data(), str.data() + str.length(), result).ec == std::errc{}) {
-		return result;
-	}
-
-	return 0;
-}
-
-std::vector<Blueprint> parseBlueprints(std::vector<std::string> const& lines) {
+std::vector<Blueprint> parseBlueprints(std::vector<std::string_view> const& lines) {
 	std::vector<Blueprint> blueprints;
 	blueprints.reserve(lines.size());
 
-	std::regex pattern("Blueprint [0-9]+: Each ore robot costs ([0-9]+) ore. Each clay robot costs ([0-9]+) ore. Each obsidian robot costs ([0-9]+) ore and ([0-9]+) clay. Each geode robot costs ([0-9]+) ore and ([0-9]+) obsidian.");
-
-	std::smatch match;
-
-	for(auto const& line : lines) {
-		[[unlikely]]
-		if(!std::regex_match(line, match, pattern)) {
-			crash("Could not match regex to this line: \"" + line + "\".");
-		}
-
-		[[unlikely]]
-		if(match.size() != 7) {
-			crash("Expected 7 regex groups.");
-		}
+	for(std::size_t lineIdx = 0; lineIdx < lines.size(); ++lineIdx) {
+		aoc::Scanner scanner(lines[lineIdx], lineIdx + 1);
 
-		std::string const& strOreRobotCostOre = match[1];
-		std::string const& strClayRobotCostOre = match[2];
-		std::string const& strObsidianRobotCostOre = match[3];
-		std::string const& strObsidianRobotCostClay = match[4];
-		std::string const& strGeodeRobotCostOre = match[5];
-		std::string const& strGeodeRobotCostObsidian = match[6];
+		int id{};
+		int oreRobotCostOre{};
+		int clayRobotCostOre{};
+		int obsidianRobotCostOre{};
+		int obsidianRobotCostClay{};
+		int geodeRobotCostOre{};
+		int geodeRobotCostObsidian{};
 
-		int const oreRobotCostOre = strToInt(strOreRobotCostOre);
-		int const clayRobotCostOre = strToInt(strClayRobotCostOre);
-		int const obsidianRobotCostOre = strToInt(strObsidianRobotCostOre);
-		int const obsidianRobotCostClay = strToInt(strObsidianRobotCostClay);
-		int const geodeRobotCostOre = strToInt(strGeodeRobotCostOre);
-		int const geodeRobotCostObsidian = strToInt(strGeodeRobotCostObsidian);
+		scanner.Scan("Blueprint {}: Each ore robot costs {} ore. Each clay robot costs {} ore. Each obsidian robot costs {} ore and {} clay. Each geode robot costs {} ore and {} obsidian.",
+			id, oreRobotCostOre, clayRobotCostOre, obsidianRobotCostOre, obsidianRobotCostClay, geodeRobotCostOre, geodeRobotCostObsidian);
+		scanner.ExpectEnd();
 
 		Blueprint blueprint{
 			.oreRobotCost = Price{.ores = oreRobotCostOre},
@@ -117,16 +79,9 @@ struct Search {
 	bool operator==(Search const&) const noexcept = default;
 };
 
-template<>
-struct std::hash<Search> {
-	size_t operator()(Search const& search) const noexcept {
-		static std::hash<int> hashInt{};
-
-		return hashInt(search.ore) ^ hashInt(search.clay) ^ hashInt(search.obsidian) ^ hashInt(search.geode) ^ hashInt(search.oreRobots) ^ hashInt(search.clayRobots) ^ hashInt(search.obsidianRobots) ^ hashInt(search.geodeRobots) ^ hashInt(search.time);
-	}
-};
-
 int evaluateBlueprint(Blueprint const& blueprint, int time) {
+	AOC_SCOPED_TIMER("day19.evaluate_blueprint");
+
 	std::stack<Search> ss;
 
 	auto getTimeToReach = [](int currentAmount, int expectedAmount, int numberOfRobots, bool& isPossible) -> int {
@@ -180,8 +135,20 @@ int evaluateBlueprint(Blueprint const& blueprint, int time) {
 		state.obsidian -= price.obsidian;
 	};
 
+	// Different build orders often end up in the same state, whose subtree only needs searching once. Only
+	// states with some time left are remembered: the last minutes hold most of the states but their subtrees
+	// are tiny, so remembering them costs far more memory than it saves time (about 16 s and 150 MB on
+	// the real input, against 80 s and 3.6 GB when every state is kept).
+	static constexpr int rememberedUntilTimeLeft = 7;
+
+	aoc::FlatSet<Search> seenStates;
+
 	int maxGeode = 0;
-	auto push = [&ss](Search&& state) mutable -> void {
+	auto push = [&ss, &seenStates, time](Search&& state) mutable -> void {
+		if(time - state.time > rememberedUntilTimeLeft && !seenStates.Insert(state)) {
+			AOC_COUNT("day19.states_repeated");
+			return;
+		}
 
 		ss.push(std::move(state));
 	};
@@ -192,6 +159,8 @@ int evaluateBlueprint(Blueprint const& blueprint, int time) {
 		auto state = ss.top();
 		ss.pop();
 
+		AOC_COUNT("day19.states_popped");
+
 		bool canMakeOreRobot, canMakeClayRobot, canMakeObsidianRobot, canMakeGeodeRobot;
 		int timeToOreRobot = getTimeToAfford(blueprint.oreRobotCost, state, canMakeOreRobot);
 		int timeToClayRobot = getTimeToAfford(blueprint.clayRobotCost, state, canMakeClayRobot);
@@ -238,27 +207,55 @@ int evaluateBlueprint(Blueprint const& blueprint, int time) {
 	return maxGeode;
 }
 
-std::vector<int> evaluateBlueprints(std::vector<Blueprint> const& blueprints, int time) {
-	std::vector<int> values;
-	values.reserve(blueprints.size());
+// Blueprints are independent searches, one task each; the results are logged in order afterwards.
+// Every finished blueprint is checkpointed (-1 marks one still to do), so a restarted run only
+// searches the blueprints it had not finished yet.
+std::vector<int> evaluateBlueprints(std::vector<Blueprint> const& blueprints, int time, aoc::Checkpoint const& checkpoint) {
+	std::vector<int> values(blueprints.size(), -1);
+
+	auto const record = "blueprints-" + std::to_string(time);
 
-	for(int blueprintCount = 0;  auto const& blueprint : blueprints) {
-		std::cout << "Evaluating blueprint " << (++blueprintCount) << "/" << blueprints.size() << '\n';
-		values.emplace_back(evaluateBlueprint(blueprint, time));
-		std::cout << "\t" << values.back() << '\n';
+	if(checkpoint.Load(record, std::span<int>(values))) {
+		AOC_INFO("Resuming " << std::ranges::count(values, -1) << " of " << blueprints.size() << " blueprints\n");
+	}
+	else {
+		AOC_INFO("Evaluating " << blueprints.size() << " blueprints\n");
+	}
+
+	std::mutex checkpointMutex;
+
+	aoc::parallelFor(0, (long long)(blueprints.size()), [&](long long idx) {
+		if(values[idx] >= 0) {
+			return;
+		}
+
+		int const value = evaluateBlueprint(blueprints[idx], time);
+
+		std::lock_guard lock(checkpointMutex);
+		values[idx] = value;
+		checkpoint.Save(record, std::span<int const>(values));
+	}, 1);
+
+	for(std::size_t idx = 0; idx < values.size(); ++idx) {
+		AOC_INFO("\tBlueprint " << (idx + 1) << ": " << values[idx] << '\n');
 	}
 
 	return values;
 }
 
-int main() {
-	auto lines = readLines("input.txt");
+aoc::Answers solve(std::string_view input) {
+	auto const lines = aoc::splitLines(input);
 
 	auto blueprints = parseBlueprints(lines);
 
-	auto firstThreeBlueprints = std::vector<Blueprint>(blueprints.begin(), std::next(blueprints.begin(), 3));
+	aoc::markParsed();
 
-	auto firstThreeBlueprintsValues = evaluateBlueprints(firstThreeBlueprints, 32);
+	aoc::Checkpoint const checkpoint("19ab", solverVersion, input);
+
+	// the example only has 2 blueprints
+	auto firstThreeBlueprints = std::vector<Blueprint>(blueprints.begin(), std::next(blueprints.begin(), std::min(3, int(blueprints.size()))));
+
+	auto firstThreeBlueprintsValues = evaluateBlueprints(firstThreeBlueprints, 32, checkpoint);
 
 	int firstThreeSums = 1;
 
@@ -266,9 +263,7 @@ int main() {
 		firstThreeSums *= blueprintValue;
 	}
 
-	std::cout << "Result 2: " << firstThreeSums << std::endl;
-
-	auto blueprintValues = evaluateBlueprints(blueprints, 24);
+	auto blueprintValues = evaluateBlueprints(blueprints, 24, checkpoint);
 
 	int sum = 0;
 
@@ -276,8 +271,24 @@ int main() {
 		sum += (++blueprintCount) * blueprintValue;
 	}
 
-	std::cout << "Result: " << sum << '\n';
+	checkpoint.Discard();
+
+	return { .Part1 = sum, .Part2 = firstThreeSums };
+}
+
+}
+
+#ifndef AOC_DRIVER
+int main() {
+	aoc::PuzzleInput input("input.txt");
+
+	auto const answers = Day19ab::solve(input.Data());
+
+	std::cout << "Result 2: " << aoc::toString(answers.Part2) << std::endl;
+
+	std::cout << "Result: " << aoc::toString(answers.Part1) << '\n';
 
 
 	return 0;
-}
\ No newline at end of file
+}
+#endif
\ No newline at end of file
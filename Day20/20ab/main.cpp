@@ -1,57 +1,27 @@
 #include <algorithm>
-#include <charconv>
-#include <fstream>
+#include <cstdio>
+#include <cstdlib>
 #include <iostream>
 #include <numeric>
 #include <string>
 #include <vector>
 
-using bigInt = long long;
-
-void crash(std::string const& message) {
-	std::cerr << message << std::endl;
-	std::terminate();
-}
-
-int strToInt(std::string_view str) {
-	[[likely]]
-	if(int result; std::from_chars(str.data(), str.data() + str.length(), result).ec == std::errc{}) {
-		return result;
-	}
-
-	crash("Could not parse int: " + std::string(str));
-	return 0;
-}
-
-std::vector<std::string> readLines(std::string const& file) {
-	std::ifstream input(file);
-
-	[[unlikely]]
-	if(!input.is_open()) {
-		crash("Could not open the input file.");
-	}
-
-	std::vector<std::string> lines;
-
-	{
-		std::string line;
+#include "../../Common/crash.h"
+#include "../../Common/input.h"
+#include "../../Common/metrics.h"
+#include "../../Common/numbers.h"
+#include "../../Common/solver.h"
+#include "../../Common/stream.h"
 
-		while(std::getline(input, line)) {
-			lines.emplace_back(line);
-		}
+namespace Day20ab {
 
-	}
-	
-	input.close();
-
-	return lines;
-}
+using bigInt = long long;
 
-std::vector<int> parseLines(std::vector<std::string> const& lines) {
+std::vector<int> parseLines(aoc::LineReader& lines) {
 	std::vector<int> ret;
 
-	for(auto const& line : lines) {
-		ret.emplace_back(strToInt(line));
+	for(std::string_view line; lines.Next(line);) {
+		ret.emplace_back(aoc::parseInt(line));
 	}
 
 	return ret;
@@ -78,6 +48,8 @@ void shift(std::vector<T>& elements, std::vector<int>& originalElementIdx, std::
 
 	int const advanceOffset = targetIndex < index ? -1 : 1;
 
+	AOC_COUNT_ADD("day20.swaps", std::abs(int(targetIndex) - int(index)));
+
 	for(int i = int(index); i != int(targetIndex); i += advanceOffset) {
 		auto advancedI = i + advanceOffset;
 
@@ -108,17 +80,30 @@ void printVector(std::vector<T> const & elements) {
 
 template<typename T>
 void decrypt(std::vector<T>& elements, std::vector<int>& originalElementIdx, std::vector<int>& whereIs) {
+	AOC_SCOPED_TIMER("day20.mix");
 
 	for(int i = 0; i < int(elements.size()); ++i) {
 		shift(elements, originalElementIdx, whereIs, T(whereIs[i]), T(elements[whereIs[i]]));
 	}
 }
 
-int main() {
-
-	auto lines = readLines("input.txt");
+aoc::Answers solveLines(aoc::LineReader& lines) {
 
 	auto elements = parseLines(lines);
+
+	// mixing moves numbers around the other n - 1, and the coordinates are counted from the 0
+	[[unlikely]]
+	if(elements.size() < 2) {
+		aoc::crash("The file needs at least two numbers to mix");
+	}
+
+	[[unlikely]]
+	if(std::find(elements.begin(), elements.end(), 0) == elements.end()) {
+		aoc::crash("The file has no 0 to count the coordinates from");
+	}
+
+	aoc::markParsed();
+
 	std::vector<bigInt> biggerElements(elements.begin(), elements.end());
 
 	std::vector<int> originalElementIdx(elements.size());
@@ -139,8 +124,6 @@ int main() {
 		sum += y;
 	}
 
-	std::cout << "Result 1: " << sum << std::endl;
-
 	for(auto& element : biggerElements) {
 		element *= 811589153LL;
 	}
@@ -158,7 +141,36 @@ int main() {
 		sum2 += bigInt(y);
 	}
 
-	std::cout << "Result 2: " << sum2 << std::endl;
+	return { .Part1 = sum, .Part2 = sum2 };
+}
+
+aoc::Answers solve(std::string_view input) {
+	aoc::LineReader lines(input);
+	return solveLines(lines);
+}
+
+aoc::Answers solveStream(std::FILE* stream) {
+	return aoc::solvePrefetchedLines(stream, solveLines);
+}
+
+}
+
+#ifndef AOC_DRIVER
+int main(int argc, char** argv) {
+	aoc::Answers answers;
+
+	if(aoc::isStreamRequested(argc, argv)) {
+		answers = Day20ab::solveStream(stdin);
+	}
+	else {
+		aoc::PuzzleInput input("input.txt");
+		answers = Day20ab::solve(input.Data());
+	}
+
+	std::cout << "Result 1: " << aoc::toString(answers.Part1) << std::endl;
+
+	std::cout << "Result 2: " << aoc::toString(answers.Part2) << std::endl;
 
 	return 0;
-}
\ No newline at end of file
+}
+#endif
\ No newline at end of file
@@ -1,5 +1,4 @@
-#include <charconv>
-#include <fstream>
+#include <cstdio>
 #include <functional>
 #include <iostream>
 #include <ranges>
@@ -10,74 +9,53 @@
 #include <variant>
 #include <vector>
 
+#include "../../Common/crash.h"
+#include "../../Common/input.h"
+#include "../../Common/numbers.h"
+#include "../../Common/solver.h"
+#include "../../Common/stream.h"
+
+namespace Day21ab {
+
 using Tint = long long;
 using Tid = long long;
 
-void crash(std::string const& message) {
-	std::cerr << message << std::endl;
-	std::terminate();
-}
-
-Tint strToInt(std::string_view message) {
-	[[likely]]
-	if(Tint result; std::from_chars(message.data(), message.data() + message.length(), result).ec == std::errc{}) {
-		return result;
-	}
+using aoc::crash;
 
-	crash("Could not parse int from: " + std::string(message));
-	return 0;
-}
+// owned by a single parse, so several inputs can be solved side by side
+class MonkeyNames {
+public:
+	Tid GetMonkeyId(std::string const& name) const {
+		auto const it = StrToIdMap.find(name);
 
-std::vector<std::string> readLines(std::string const& file) {
-	std::ifstream input(file);
+		[[unlikely]]
+		if(it == StrToIdMap.end()) {
+			crash("Monkey with name " + name + " does not exist!");
+		}
 
-	[[unlikely]]
-	if(!input.is_open()) {
-		crash("Could not open the input file.");
+		return it->second;
 	}
 
-	std::vector<std::string> lines;
-
-	{
-		std::string line;
+	std::string const& GetMonkeyName(Tid id) const {
+		auto const it = IdToStrMap.find(id);
 
-		while(std::getline(input, line)) {
-			lines.emplace_back(line);
+		[[unlikely]]
+		if(it == IdToStrMap.end()) {
+			crash("Monkey with id " + std::to_string(id) + " does not exist!");
 		}
-	}
-
-	input.close();
-
-	return lines;
-}
-
-namespace {
-	std::unordered_map<Tid, std::string> idToStrMap;
-	std::unordered_map<std::string, Tid> strToIdMap;
-}
 
-Tid getMonkeyId(std::string const& name) {
-	[[unlikely]]
-	if(strToIdMap.count(name) == 0) {
-		crash("Monkey with name " + name + " does not exist!");
+		return it->second;
 	}
 
-	return strToIdMap[name];
-}
-
-std::string const& getMonkeyName(Tid id) {
-	[[unlikely]]
-	if(idToStrMap.count(id) == 0) {
-		crash("Monkey with id " + std::to_string(id) + " does not exist!");
+	void RegisterMonkey(Tid id, std::string const& name) {
+		IdToStrMap[id] = name;
+		StrToIdMap[name] = id;
 	}
 
-	return idToStrMap[id];
-}
-
-void registerMonkey(Tid id, std::string const& name) {
-	idToStrMap[id] = name;
-	strToIdMap[name] = id;
-}
+private:
+	std::unordered_map<Tid, std::string> IdToStrMap;
+	std::unordered_map<std::string, Tid> StrToIdMap;
+};
 
 
 
@@ -102,7 +80,7 @@ struct Monkey {
 	std::function<Tint(Tint, Tint)> InverseParentRight{};
 };
 
-std::vector<std::string> parseLine(std::string const& line, Monkey& monkey) {
+std::vector<std::string> parseLine(std::string_view line, Monkey& monkey, MonkeyNames& monkeyNames) {
 	auto r = line |
 		std::views::split(std::string_view(" "));
 
@@ -112,7 +90,7 @@ std::vector<std::string> parseLine(std::string const& line, Monkey& monkey) {
 
 	std::string_view name(nameRange.begin(), std::prev(nameRange.end()));
 
-	registerMonkey(monkey.Id, std::string(name));
+	monkeyNames.RegisterMonkey(monkey.Id, std::string(name));
 
 	std::vector<std::string> dependencies;
 
@@ -121,7 +99,7 @@ std::vector<std::string> parseLine(std::string const& line, Monkey& monkey) {
 
 		std::string_view numberStr(numberRange.begin(), numberRange.end());
 
-		Tint const number = strToInt(numberStr);
+		Tint const number = aoc::parseInt<Tint>(numberStr);
 
 		monkey.Operation = [number](Tint, Tint) -> Tint { return number; };
 	}
@@ -175,34 +153,33 @@ std::vector<std::string> parseLine(std::string const& line, Monkey& monkey) {
 	return dependencies;
 }
 
-std::vector<Tid> parseDependencies(std::vector<std::string> const& rawDependencies) {
+std::vector<Tid> parseDependencies(std::vector<std::string> const& rawDependencies, MonkeyNames const& monkeyNames) {
 	std::vector<Tid> dependencies;
 	dependencies.reserve(rawDependencies.size());
 
 	for(auto const& dependency : rawDependencies) {
-		dependencies.emplace_back(getMonkeyId(dependency));
+		dependencies.emplace_back(monkeyNames.GetMonkeyId(dependency));
 	}
 
 	return dependencies;
 }
 
-std::vector<Monkey> parseInput(std::vector<std::string> const& lines) {
-	std::vector<Monkey> monkeys(lines.size());
+std::vector<Monkey> parseInput(aoc::LineReader& lines, MonkeyNames& monkeyNames) {
+	std::vector<Monkey> monkeys;
 
 	std::vector<std::vector<std::string>> dependencies;
-	dependencies.reserve(lines.size());
 
-	for(Tid i = 0; i < Tid(monkeys.size()); ++i) {
-		Monkey& monkey = monkeys[i];
-		monkey.Id = i;
+	for(std::string_view line; lines.Next(line);) {
+		Monkey& monkey = monkeys.emplace_back();
+		monkey.Id = Tid(monkeys.size() - 1);
 
-		dependencies.emplace_back(parseLine(lines[i], monkey));
+		dependencies.emplace_back(parseLine(line, monkey, monkeyNames));
 	}
 
 	for(Tid i = 0; i < Tid(monkeys.size()); ++i) {
 		Monkey& monkey = monkeys[i];
 
-		monkey.BeforeDependencies = parseDependencies(dependencies[i]);
+		monkey.BeforeDependencies = parseDependencies(dependencies[i], monkeyNames);
 
 		monkey.UnsatistiedDependencies.insert(monkey.BeforeDependencies.begin(), monkey.BeforeDependencies.end());
 
@@ -264,12 +241,12 @@ void solveMonkeys(std::vector<Monkey>& monkeys) {
 	}
 }
 
-Tint solveHuman(std::vector<Monkey> const& monkeys) {
+Tint solveHuman(std::vector<Monkey> const& monkeys, MonkeyNames const& monkeyNames) {
 	std::stack<Tid> humanStack;
 
-	humanStack.push(getMonkeyId("humn"));
+	humanStack.push(monkeyNames.GetMonkeyId("humn"));
 
-	auto const rootId = getMonkeyId("root");
+	auto const rootId = monkeyNames.GetMonkeyId("root");
 
 	while(humanStack.top() != rootId) {
 		auto const nextMonkey = monkeys[humanStack.top()].AfterDependencies.front();
@@ -309,21 +286,50 @@ Tint solveHuman(std::vector<Monkey> const& monkeys) {
 	return result;
 }
 
-int main() {
+aoc::Answers solveLines(aoc::LineReader& lines) {
+
+	MonkeyNames monkeyNames;
 
-	auto lines = readLines("input.txt");
+	auto monkeys = parseInput(lines, monkeyNames);
 
-	auto monkeys = parseInput(lines);
+	aoc::markParsed();
 
 	solveMonkeys(monkeys);
 
-	auto rootMonkeyId = getMonkeyId("root");
+	auto rootMonkeyId = monkeyNames.GetMonkeyId("root");
+
+	auto human = solveHuman(monkeys, monkeyNames);
+
+	return { .Part1 = monkeys[rootMonkeyId].Solution, .Part2 = human };
+}
+
+aoc::Answers solve(std::string_view input) {
+	aoc::LineReader lines(input);
+	return solveLines(lines);
+}
+
+aoc::Answers solveStream(std::FILE* stream) {
+	return aoc::solvePrefetchedLines(stream, solveLines);
+}
+
+}
+
+#ifndef AOC_DRIVER
+int main(int argc, char** argv) {
+	aoc::Answers answers;
 
-	std::cout << "Result 1: " << monkeys[rootMonkeyId].Solution << std::endl;
+	if(aoc::isStreamRequested(argc, argv)) {
+		answers = Day21ab::solveStream(stdin);
+	}
+	else {
+		aoc::PuzzleInput input("input.txt");
+		answers = Day21ab::solve(input.Data());
+	}
 
-	auto human = solveHuman(monkeys);
+	std::cout << "Result 1: " << aoc::toString(answers.Part1) << std::endl;
 
-	std::cout << "Result 2: " << human << std::endl;
+	std::cout << "Result 2: " << aoc::toString(answers.Part2) << std::endl;
 
 	return 0;
 }
+#endif
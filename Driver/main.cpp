@@ -0,0 +1,138 @@
+#include "solvers.h"
+
+#include <cstdio>
+#include <iostream>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "../Common/cache.h"
+#include "../Common/checkpoint.h"
+#include "../Common/cli.h"
+#include "../Common/crash.h"
+#include "../Common/input.h"
+#include "../Common/solver.h"
+#include "../Common/stream.h"
+#include "../Common/tasks.h"
+
+// Usage: driver [--root <repository root>] [--threads <n>] [--cache <directory>] [--checkpoint <directory>] [<day>[=<input file>]...]
+// Without any day every solver runs on its own input.txt. --threads sizes the task pool the parallel
+// solvers share, the default is AOC_THREADS or every hardware thread. "-" as the input file reads stdin, in chunks
+// for the solvers that can stream and all at once for the others. --cache answers inputs seen before from
+// the given directory without solving them again; streamed inputs are never cached. --checkpoint keeps the
+// progress of the long searches there (default AOC_CHECKPOINT_DIR), so an interrupted run resumes.
+
+constexpr std::string_view usage = "Usage: driver [--root <repository root>] [--threads <n>] [--cache <directory>] [--checkpoint <directory>] [<day>[=<input file>]...]";
+
+void printAnswer(std::string_view label, aoc::Answer const& answer) {
+	auto const text = aoc::toString(answer);
+
+	if(text.find('\n') != std::string::npos) {
+		std::cout << '\t' << label << ":\n" << text;
+
+		if(text.back() != '\n') {
+			std::cout << '\n';
+		}
+	}
+	else {
+		std::cout << '\t' << label << ": " << text << '\n';
+	}
+}
+
+int main(int argc, char** argv) {
+	std::string root = ".";
+	std::optional<aoc::ResultCache> cache;
+
+	std::vector<std::pair<aoc::Solver const*, std::string>> runs;
+
+	std::vector<std::string_view> const args(argv + 1, argv + argc);
+
+	for(std::size_t i = 0; i < args.size(); ++i) {
+		auto const arg = args[i];
+
+		if(arg == "--root") {
+			[[unlikely]]
+			if(i + 1 >= args.size()) {
+				return aoc::failUsage(usage, "--root expects a directory");
+			}
+
+			root = args[++i];
+			continue;
+		}
+
+		if(arg == "--cache") {
+			[[unlikely]]
+			if(i + 1 >= args.size()) {
+				return aoc::failUsage(usage, "--cache expects a directory");
+			}
+
+			cache.emplace(std::string(args[++i]));
+			continue;
+		}
+
+		if(arg == "--checkpoint") {
+			[[unlikely]]
+			if(i + 1 >= args.size()) {
+				return aoc::failUsage(usage, "--checkpoint expects a directory");
+			}
+
+			aoc::setCheckpointDirectory(std::string(args[++i]));
+			continue;
+		}
+
+		if(arg == "--threads") {
+			auto const threads = aoc::parseThreadCount(i + 1 < args.size() ? args[++i] : std::string_view());
+
+			[[unlikely]]
+			if(!threads) {
+				return aoc::failUsage(usage, "--threads expects a positive number");
+			}
+
+			aoc::setThreadCount(*threads);
+			continue;
+		}
+
+		auto const separator = arg.find('=');
+		auto const selector = arg.substr(0, separator);
+		auto const selected = aoc::selectSolvers(selector);
+
+		[[unlikely]]
+		if(selected.empty()) {
+			return aoc::failUsage(usage, "Unknown day " + std::string(selector));
+		}
+
+		for(auto const* solver : selected) {
+			runs.emplace_back(solver, separator == std::string_view::npos ? std::string() : std::string(arg.substr(separator + 1)));
+		}
+	}
+
+	if(runs.empty()) {
+		for(auto const& solver : aoc::solvers) {
+			runs.emplace_back(&solver, std::string());
+		}
+	}
+
+	for(auto& [solver, path] : runs) {
+		if(path.empty()) {
+			path = root + "/" + std::string(solver->Directory) + "/input.txt";
+		}
+
+		aoc::Answers answers;
+
+		if(path == "-") {
+			answers = solver->Stream ? solver->Stream(stdin) : solver->Solve(aoc::readAll(stdin));
+		}
+		else {
+			aoc::MappedFile input(path);
+			answers = cache ? cache->Solve(*solver, input.Data()) : solver->Solve(input.Data());
+		}
+
+		std::cout << solver->Id << '\n';
+		printAnswer("Part 1", answers.Part1);
+		printAnswer("Part 2", answers.Part2);
+	}
+
+	return 0;
+}
@@ -0,0 +1,88 @@
+#pragma once
+
+// Unity build of every day. Each main.cpp keeps its own main() behind AOC_DRIVER and its code in a
+// namespace named after its directory, so all of them can live in one binary.
+#ifndef AOC_DRIVER
+#define AOC_DRIVER
+#endif
+
+#include "../Day02/02a/game.cpp"
+#include "../Day02/02a/main.cpp"
+#include "../Day02/02b/main.cpp"
+#include "../Day03/03a/main.cpp"
+#include "../Day03/03b/main.cpp"
+#include "../Day04/04ab/main.cpp"
+#include "../Day05/05ab/main.cpp"
+#include "../Day06/06a/main.cpp"
+#include "../Day06/06b/main.cpp"
+#include "../Day07/07ab/main.cpp"
+#include "../Day08/08ab/main.cpp"
+#include "../Day09/09a/main.cpp"
+#include "../Day09/09b/main.cpp"
+#include "../Day10/10ab/main.cpp"
+#include "../Day11/11a/main.cpp"
+#include "../Day11/11b/main.cpp"
+#include "../Day12/12ab/main.cpp"
+#include "../Day13/13ab/main.cpp"
+#include "../Day14/14a/main.cpp"
+#include "../Day14/14b/main.cpp"
+#include "../Day15/15a/main.cpp"
+#include "../Day15/15b/main.cpp"
+#include "../Day16/16ab/main.cpp"
+#include "../Day17/17ab/main.cpp"
+#include "../Day18/18ab/main.cpp"
+#include "../Day19/19ab/main.cpp"
+#include "../Day20/20ab/main.cpp"
+#include "../Day21/21ab/main.cpp"
+
+#include "../Common/solver.h"
+
+#include <array>
+
+namespace aoc {
+
+	// Day01 is the Python script and is not part of the driver.
+	inline constexpr std::array solvers{
+		Solver{ "02a", "Day02/02a", &Day02a::solve },
+		Solver{ "02b", "Day02/02b", &Day02b::solve, &Day02b::solveStream },
+		Solver{ "03a", "Day03/03a", &Day03a::solve, &Day03a::solveStream },
+		Solver{ "03b", "Day03/03b", &Day03b::solve, &Day03b::solveStream },
+		Solver{ "04ab", "Day04/04ab", &Day04ab::solve, &Day04ab::solveStream },
+		Solver{ "05ab", "Day05/05ab", &Day05ab::solve, &Day05ab::solveStream },
+		Solver{ "06a", "Day06/06a", &Day06a::solve, &Day06a::solveStream },
+		Solver{ "06b", "Day06/06b", &Day06b::solve, &Day06b::solveStream },
+		Solver{ "07ab", "Day07/07ab", &Day07ab::solve, &Day07ab::solveStream },
+		Solver{ "08ab", "Day08/08ab", &Day08ab::solve },
+		Solver{ "09a", "Day09/09a", &Day09a::solve, &Day09a::solveStream },
+		Solver{ "09b", "Day09/09b", &Day09b::solve, &Day09b::solveStream },
+		Solver{ "10ab", "Day10/10ab", &Day10ab::solve, &Day10ab::solveStream, Day10ab::solverVersion },
+		Solver{ "11a", "Day11/11a", &Day11a::solve },
+		Solver{ "11b", "Day11/11b", &Day11b::solve },
+		Solver{ "12ab", "Day12/12ab", &Day12ab::solve },
+		Solver{ "13ab", "Day13/13ab", &Day13ab::solve },
+		Solver{ "14a", "Day14/14a", &Day14a::solve },
+		Solver{ "14b", "Day14/14b", &Day14b::solve },
+		Solver{ "15a", "Day15/15a", &Day15a::solve },
+		Solver{ "15b", "Day15/15b", &Day15b::solve },
+		Solver{ "16ab", "Day16/16ab", &Day16ab::solve, nullptr, Day16ab::solverVersion },
+		Solver{ "17ab", "Day17/17ab", &Day17ab::solve },
+		Solver{ "18ab", "Day18/18ab", &Day18ab::solve },
+		Solver{ "19ab", "Day19/19ab", &Day19ab::solve, nullptr, Day19ab::solverVersion },
+		Solver{ "20ab", "Day20/20ab", &Day20ab::solve, &Day20ab::solveStream },
+		Solver{ "21ab", "Day21/21ab", &Day21ab::solve, &Day21ab::solveStream },
+	};
+
+	// "16" selects every solver of that day, "16ab" exactly one.
+	inline std::vector<Solver const*> selectSolvers(std::string_view selector) {
+		std::vector<Solver const*> selected;
+
+		for(auto const& solver : solvers) {
+			if(solver.Id.starts_with(selector)) {
+				selected.emplace_back(&solver);
+			}
+		}
+
+		return selected;
+	}
+
+}
@@ -0,0 +1,79 @@
+#include <cstdio>
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "../Common/cli.h"
+#include "../Common/input.h"
+
+// Usage: embed <input file> [<output header>]
+// Writes the bytes of the input as a comma separated list, to be included into the array behind
+// aoc::PuzzleInput by compilers without #embed. The header defaults to the input's name with .embed.h in
+// place of its extension; generated headers are not checked in. For example, from a day's directory:
+//     embed input.txt
+//     g++ -std=c++2b -O2 -I. -DAOC_EMBED_INPUT_ARRAY='"input.embed.h"' main.cpp
+// and with a compiler that has #embed, no header is needed:
+//     g++ -std=c++2b -O2 --embed-dir=. -DAOC_EMBED_INPUT='"input.txt"' main.cpp
+
+constexpr std::string_view usage = "Usage: embed <input file> [<output header>]";
+
+int main(int argc, char** argv) {
+	std::vector<std::string_view> const args(argv + 1, argv + argc);
+
+	[[unlikely]]
+	if(args.empty() || args.size() > 2) {
+		return aoc::failUsage(usage, "Expected an input file and optionally an output header");
+	}
+
+	std::string const inputPath(args[0]);
+	std::string outputPath;
+
+	if(args.size() == 2) {
+		outputPath = args[1];
+	}
+	else {
+		auto const extension = inputPath.find_last_of('.');
+		auto const directory = inputPath.find_last_of("/\\");
+		auto const stem = extension != std::string::npos && (directory == std::string::npos || extension > directory) ? inputPath.substr(0, extension) : inputPath;
+
+		outputPath = stem + ".embed.h";
+	}
+
+	aoc::MappedFile input(inputPath);
+	auto const data = input.Data();
+
+	[[unlikely]]
+	if(data.empty()) {
+		std::cerr << "Cannot embed the empty file " << inputPath << '\n';
+		return 1;
+	}
+
+	std::FILE* const output = std::fopen(outputPath.c_str(), "wb");
+
+	[[unlikely]]
+	if(!output) {
+		std::cerr << "Could not create " << outputPath << '\n';
+		return 1;
+	}
+
+	std::string text = "// generated by embed from " + inputPath + ", do not edit\n";
+	text.reserve(text.size() + data.size() * 4 + data.size() / 16);
+
+	constexpr std::size_t bytesPerLine = 24;
+
+	for(std::size_t i = 0; i < data.size(); ++i) {
+		text += std::to_string(int(static_cast<unsigned char>(data[i])));
+		text += (i + 1) % bytesPerLine == 0 || i + 1 == data.size() ? ",\n" : ",";
+	}
+
+	bool const isWritten = std::fwrite(text.data(), 1, text.size(), output) == text.size();
+
+	[[unlikely]]
+	if(std::fclose(output) != 0 || !isWritten) {
+		std::cerr << "Could not write " << outputPath << '\n';
+		return 1;
+	}
+
+	return 0;
+}
@@ -0,0 +1,885 @@
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <limits>
+#include <numeric>
+#include <optional>
+#include <random>
+#include <string>
+#include <string_view>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include "../Common/cli.h"
+#include "../Common/crash.h"
+
+// Usage: generator <day> [--scale <n>] [--seed <n>] [--output <file>]
+//        generator --list
+// Writes a valid puzzle input for <day> (02 to 21, both parts of a day share the format) at the chosen
+// scale. The same seed always produces the same input, so generated files can be compared across builds,
+// compilers and standard libraries.
+
+// The distributions and std::shuffle of the standard library differ between implementations, only the
+// engine's output is specified, so everything is derived from that directly.
+class Random {
+public:
+	explicit Random(unsigned long long seed) : Engine(seed) {}
+
+	// inclusive on both ends
+	long long Between(long long min, long long max) {
+		auto const span = (unsigned long long)(max) - (unsigned long long)(min) + 1;
+
+		if(span == 0) {
+			return (long long)(Engine());
+		}
+
+		// rejects the lowest 2^64 % span values, so every remainder is equally likely
+		auto const threshold = (0 - span) % span;
+
+		for(;;) {
+			auto const value = Engine();
+
+			if(value >= threshold) {
+				return (long long)((unsigned long long)(min) + value % span);
+			}
+		}
+	}
+
+	bool Chance(double probability) {
+		// the top 53 bits make an exact double in [0, 1)
+		return double(Engine() >> 11) * 0x1.0p-53 < probability;
+	}
+
+	template<typename T>
+	T const& Pick(std::vector<T> const& values) {
+		return values[Between(0, (long long)(values.size()) - 1)];
+	}
+
+	// Fisher-Yates
+	template<typename Container>
+	void Shuffle(Container& values) {
+		for(auto i = (long long)(values.size()) - 1; i > 0; --i) {
+			std::swap(values[std::size_t(i)], values[std::size_t(Between(0, i))]);
+		}
+	}
+
+private:
+	std::mt19937_64 Engine;
+};
+
+using GenerateFunction = void(*)(std::ostream& output, Random& random, long long scale);
+
+struct Generator {
+	std::string_view Day;
+	long long DefaultScale;
+	std::string_view ScaleMeaning;
+	GenerateFunction Generate;
+	// the smallest input the generator can write and the day's solver accepts
+	long long MinScale = 1;
+	// the largest input the day's solver accepts
+	long long MaxScale = std::numeric_limits<long long>::max();
+};
+
+// Distinct names of `length` lowercase letters that avoid the reserved ones.
+std::vector<std::string> makeNames(Random& random, long long count, int length, std::unordered_set<std::string> reserved = {}) {
+	std::vector<std::string> names;
+	names.reserve(count);
+
+	while((long long)(names.size()) < count) {
+		std::string name(length, 'a');
+
+		for(auto& c : name) {
+			c = char('a' + random.Between(0, 25));
+		}
+
+		if(reserved.insert(name).second) {
+			names.emplace_back(std::move(name));
+		}
+	}
+
+	return names;
+}
+
+void generateDay02(std::ostream& output, Random& random, long long scale) {
+	for(long long i = 0; i < scale; ++i) {
+		output << char('A' + random.Between(0, 2)) << ' ' << char('X' + random.Between(0, 2)) << '\n';
+	}
+}
+
+// Every rucksack has exactly one item type in both compartments and every group of three shares exactly
+// one badge, so the same file is valid for both parts.
+void generateDay03(std::ostream& output, Random& random, long long scale) {
+	static constexpr std::string_view itemTypes = "abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ";
+
+	std::vector<char> types(itemTypes.begin(), itemTypes.end());
+
+	for(long long group = 0; group < (scale + 2) / 3; ++group) {
+		random.Shuffle(types);
+
+		char const badge = types.back();
+
+		for(int elf = 0; elf < 3; ++elf) {
+			// disjoint pools per elf, so the badge is the only type all three carry
+			std::vector<char> pool(types.begin() + elf * 17, types.begin() + (elf + 1) * 17);
+
+			char const shared = pool.back();
+			pool.pop_back();
+
+			std::vector<char> leftTypes(pool.begin(), pool.begin() + 8);
+			std::vector<char> rightTypes(pool.begin() + 8, pool.end());
+
+			auto const halfSize = random.Between(3, 16);
+
+			std::string left{ badge, shared };
+			std::string right{ shared };
+
+			while((long long)(left.size()) < halfSize) {
+				left.push_back(random.Pick(leftTypes));
+			}
+
+			while((long long)(right.size()) < halfSize) {
+				right.push_back(random.Pick(rightTypes));
+			}
+
+			random.Shuffle(left);
+			random.Shuffle(right);
+
+			output << left << right << '\n';
+		}
+	}
+}
+
+void generateDay04(std::ostream& output, Random& random, long long scale) {
+	for(long long i = 0; i < scale; ++i) {
+		auto const a = random.Between(1, 99);
+		auto const b = random.Between(a, 99);
+		auto const c = random.Between(1, 99);
+		auto const d = random.Between(c, 99);
+
+		output << a << '-' << b << ',' << c << '-' << d << '\n';
+	}
+}
+
+// Moves never empty a stack, so both parts always have a top crate to report.
+void generateDay05(std::ostream& output, Random& random, long long scale) {
+	int const stackCount = 9;
+
+	std::vector<long long> heights(stackCount);
+
+	for(auto& height : heights) {
+		height = random.Between(1, 8);
+	}
+
+	long long const maxHeight = *std::max_element(heights.begin(), heights.end());
+
+	for(long long level = maxHeight - 1; level >= 0; --level) {
+		for(int stack = 0; stack < stackCount; ++stack) {
+			if(stack > 0) {
+				output << ' ';
+			}
+
+			if(heights[stack] > level) {
+				output << '[' << char('A' + random.Between(0, 25)) << ']';
+			}
+			else {
+				output << "   ";
+			}
+		}
+
+		output << '\n';
+	}
+
+	for(int stack = 0; stack < stackCount; ++stack) {
+		output << (stack > 0 ? " " : "") << ' ' << stack + 1 << ' ';
+	}
+
+	output << "\n\n";
+
+	for(long long i = 0; i < scale; ++i) {
+		int source;
+
+		do {
+			source = int(random.Between(0, stackCount - 1));
+		} while(heights[source] < 2);
+
+		int target = int(random.Between(0, stackCount - 2));
+
+		if(target >= source) {
+			++target;
+		}
+
+		auto const count = random.Between(1, std::min(heights[source] - 1, 40LL));
+
+		heights[source] -= count;
+		heights[target] += count;
+
+		output << "move " << count << " from " << source + 1 << " to " << target + 1 << '\n';
+	}
+}
+
+// Only three letters until the very end, so neither marker shows up before the last 14 characters.
+void generateDay06(std::ostream& output, Random& random, long long scale) {
+	static constexpr std::string_view marker = "defghijklmnopq";
+
+	std::string signal;
+	signal.reserve(scale + marker.size());
+
+	for(long long i = 0; i < scale; ++i) {
+		signal.push_back(char('a' + random.Between(0, 2)));
+	}
+
+	signal += marker;
+
+	output << signal << '\n';
+}
+
+void generateDay07(std::ostream& output, Random& random, long long scale) {
+	long long const directoryCount = std::max(1LL, scale / 8);
+
+	std::vector<std::vector<long long>> subdirectories(directoryCount);
+	std::vector<std::vector<long long>> files(directoryCount);
+
+	for(long long directory = 1; directory < directoryCount; ++directory) {
+		subdirectories[random.Between(0, directory - 1)].emplace_back(directory);
+	}
+
+	for(long long file = 0; file < scale; ++file) {
+		files[random.Between(0, directoryCount - 1)].emplace_back(file);
+	}
+
+	// around 50000000 in total, so part 2 has to free space out of a 70000000 disk
+	long long const maxFileSize = std::max(1LL, 100000000LL / std::max(1LL, scale));
+
+	output << "$ cd /\n";
+
+	std::function<void(long long)> list = [&](long long directory) {
+		output << "$ ls\n";
+
+		for(auto const subdirectory : subdirectories[directory]) {
+			output << "dir d" << subdirectory << '\n';
+		}
+
+		for(auto const file : files[directory]) {
+			output << random.Between(1, maxFileSize) << " f" << file << ".txt\n";
+		}
+
+		for(auto const subdirectory : subdirectories[directory]) {
+			output << "$ cd d" << subdirectory << '\n';
+			list(subdirectory);
+			output << "$ cd ..\n";
+		}
+	};
+
+	list(0);
+}
+
+void generateDay08(std::ostream& output, Random& random, long long scale) {
+	std::string line(scale, '0');
+
+	for(long long y = 0; y < scale; ++y) {
+		for(auto& tree : line) {
+			tree = char('0' + random.Between(0, 9));
+		}
+
+		output << line << '\n';
+	}
+}
+
+void generateDay09(std::ostream& output, Random& random, long long scale) {
+	static constexpr std::string_view directions = "RLUD";
+
+	for(long long i = 0; i < scale; ++i) {
+		output << directions[random.Between(0, 3)] << ' ' << random.Between(1, 20) << '\n';
+	}
+}
+
+void generateDay10(std::ostream& output, Random& random, long long scale) {
+	for(long long i = 0; i < scale; ++i) {
+		if(random.Chance(0.3)) {
+			output << "noop\n";
+		}
+		else {
+			output << "addx " << random.Between(-20, 20) << '\n';
+		}
+	}
+}
+
+// Divisors are the primes up to 23, so their lcm (and its square) still fits the part 2 arithmetic.
+void generateDay11(std::ostream& output, Random& random, long long scale) {
+	static constexpr std::array<int, 9> divisors{ 2, 3, 5, 7, 11, 13, 17, 19, 23 };
+
+	long long const monkeyCount = scale;
+	long long const squaringMonkey = random.Between(0, monkeyCount - 1);
+
+	for(long long monkey = 0; monkey < monkeyCount; ++monkey) {
+		if(monkey > 0) {
+			output << '\n';
+		}
+
+		output << "Monkey " << monkey << ":\n";
+		output << "  Starting items: ";
+
+		auto const itemCount = random.Between(1, 8);
+
+		for(long long item = 0; item < itemCount; ++item) {
+			output << (item > 0 ? ", " : "") << random.Between(50, 99);
+		}
+
+		output << "\n  Operation: new = ";
+
+		if(monkey == squaringMonkey) {
+			output << "old * old";
+		}
+		else if(random.Chance(0.3)) {
+			output << "old * " << random.Between(2, 19);
+		}
+		else {
+			output << "old + " << random.Between(1, 8);
+		}
+
+		auto const trueTarget = (monkey + random.Between(1, monkeyCount - 1)) % monkeyCount;
+		auto falseTarget = trueTarget;
+
+		// with only two monkeys both targets have to be the other one
+		while(monkeyCount > 2 && (falseTarget == trueTarget || falseTarget == monkey)) {
+			falseTarget = random.Between(0, monkeyCount - 1);
+		}
+
+		output << "\n  Test: divisible by " << divisors[monkey % divisors.size()] << '\n';
+		output << "    If true: throw to monkey " << trueTarget << '\n';
+		output << "    If false: throw to monkey " << falseTarget << '\n';
+	}
+}
+
+// The top row climbs from S to E one letter at a time, so a path always exists. The rest is noise.
+// At least 26 wide to fit every letter.
+void generateDay12(std::ostream& output, Random& random, long long scale) {
+	long long const width = scale;
+	long long const height = scale;
+
+	std::string line(width, 'a');
+
+	for(long long y = 0; y < height; ++y) {
+		for(long long x = 0; x < width; ++x) {
+			line[x] = y == 0 ? char('a' + x * 26 / width) : char('a' + random.Between(0, 25));
+		}
+
+		if(y == 0) {
+			line.front() = 'S';
+			line.back() = 'E';
+		}
+
+		output << line << '\n';
+	}
+}
+
+void generatePacket(std::ostream& output, Random& random, int depth) {
+	output << '[';
+
+	auto const size = random.Between(0, 5);
+
+	for(long long i = 0; i < size; ++i) {
+		if(i > 0) {
+			output << ',';
+		}
+
+		if(depth < 4 && random.Chance(0.3)) {
+			generatePacket(output, random, depth + 1);
+		}
+		else {
+			output << random.Between(0, 10);
+		}
+	}
+
+	output << ']';
+}
+
+void generateDay13(std::ostream& output, Random& random, long long scale) {
+	for(long long pair = 0; pair < scale; ++pair) {
+		if(pair > 0) {
+			output << '\n';
+		}
+
+		generatePacket(output, random, 0);
+		output << '\n';
+		generatePacket(output, random, 0);
+		output << '\n';
+	}
+}
+
+// Rock paths scattered over a square below the sand source that grows with the path count, sparse enough
+// for the sand to find a way past them in part 1.
+void generateDay14(std::ostream& output, Random& random, long long scale) {
+	long long depth = 20;
+
+	while(depth * depth < 100 * scale) {
+		++depth;
+	}
+
+	for(long long path = 0; path < scale; ++path) {
+		long long x = 500 + random.Between(-depth, depth);
+		long long y = random.Between(10, 10 + depth);
+
+		output << x << ',' << y;
+
+		auto const segments = random.Between(1, 6);
+
+		for(long long segment = 0; segment < segments; ++segment) {
+			if(segment % 2 == 0) {
+				x += random.Between(-8, 8);
+			}
+			else {
+				y = std::max(10LL, y + random.Between(-4, 4));
+			}
+
+			output << " -> " << x << ',' << y;
+		}
+
+		output << '\n';
+	}
+}
+
+// Every sensor reaches exactly one step short of a hidden point, four of them far out on its diagonals
+// cover the rest of the 4000000 square, so part 2 has exactly one answer.
+void generateDay15(std::ostream& output, Random& random, long long scale) {
+	long long const limit = 4000000;
+
+	long long const hiddenX = random.Between(1, limit - 1);
+	long long const hiddenY = random.Between(1, limit - 1);
+
+	auto const writeSensor = [&](long long x, long long y) {
+		long long const range = std::abs(x - hiddenX) + std::abs(y - hiddenY) - 1;
+
+		// any point at exactly that distance can be its beacon
+		long long const dx = random.Between(-range, range);
+		long long const dy = (range - std::abs(dx)) * (random.Chance(0.5) ? 1 : -1);
+
+		output << "Sensor at x=" << x << ", y=" << y << ": closest beacon is at x=" << x + dx << ", y=" << y + dy << '\n';
+	};
+
+	for(auto const& [sx, sy] : { std::pair{ 1, 1 }, std::pair{ 1, -1 }, std::pair{ -1, 1 }, std::pair{ -1, -1 } }) {
+		writeSensor(hiddenX + sx * limit, hiddenY + sy * limit);
+	}
+
+	for(long long sensor = 4; sensor < scale; ++sensor) {
+		long long x, y;
+
+		do {
+			x = random.Between(0, limit);
+			y = random.Between(0, limit);
+		} while(x == hiddenX && y == hiddenY);
+
+		writeSensor(x, y);
+	}
+}
+
+// The Day16 search keeps the opened valves in a 64-bit mask, so it accepts at most this many valves with flow.
+constexpr long long day16FlowValveLimit = 64;
+
+// AA, the valves with flow and as many without. The tunnels form a random spanning tree from AA with a
+// few extra loops.
+void generateDay16(std::ostream& output, Random& random, long long scale) {
+	long long const flowValves = scale;
+	long long const valveCount = 1 + flowValves + std::max(1LL, flowValves);
+
+	std::vector<std::string> names;
+
+	for(char a = 'A'; a <= 'Z'; ++a) {
+		for(char b = 'A'; b <= 'Z'; ++b) {
+			if(a != 'A' || b != 'A') {
+				names.emplace_back(std::string{ a, b });
+			}
+		}
+	}
+
+	random.Shuffle(names);
+	names.resize(valveCount - 1);
+	names.insert(names.begin(), "AA");
+
+	std::vector<std::vector<long long>> tunnels(valveCount);
+
+	auto const connect = [&tunnels](long long a, long long b) {
+		if(a == b || std::find(tunnels[a].begin(), tunnels[a].end(), b) != tunnels[a].end()) {
+			return;
+		}
+
+		tunnels[a].emplace_back(b);
+		tunnels[b].emplace_back(a);
+	};
+
+	for(long long valve = 1; valve < valveCount; ++valve) {
+		connect(valve, random.Between(0, valve - 1));
+	}
+
+	for(long long loop = 0; loop < valveCount / 4; ++loop) {
+		connect(random.Between(0, valveCount - 1), random.Between(0, valveCount - 1));
+	}
+
+	// valve 0 is AA, which never has flow
+	std::vector<long long> order(valveCount - 1);
+	std::iota(order.begin(), order.end(), 1);
+	random.Shuffle(order);
+
+	std::vector<long long> flows(valveCount, 0);
+
+	for(long long i = 0; i < flowValves && i < (long long)(order.size()); ++i) {
+		flows[order[i]] = random.Between(1, 25);
+	}
+
+	for(long long valve = 0; valve < valveCount; ++valve) {
+		bool const isSingle = tunnels[valve].size() == 1;
+
+		output << "Valve " << names[valve] << " has flow rate=" << flows[valve] << "; ";
+		output << (isSingle ? "tunnel leads to valve " : "tunnels lead to valves ");
+
+		for(bool isFirst = true; auto const other : tunnels[valve]) {
+			output << (isFirst ? "" : ", ") << names[other];
+			isFirst = false;
+		}
+
+		output << '\n';
+	}
+}
+
+void generateDay17(std::ostream& output, Random& random, long long scale) {
+	std::string jets(scale, '<');
+
+	for(auto& jet : jets) {
+		jet = random.Chance(0.5) ? '<' : '>';
+	}
+
+	output << jets << '\n';
+}
+
+// Cubes inside a box sized for roughly a third of it to be filled, which leaves plenty of air pockets.
+void generateDay18(std::ostream& output, Random& random, long long scale) {
+	long long side = 2;
+
+	while(side * side * side < 3 * scale) {
+		++side;
+	}
+
+	std::unordered_set<long long> cubes;
+
+	while((long long)(cubes.size()) < scale) {
+		auto const x = random.Between(1, side);
+		auto const y = random.Between(1, side);
+		auto const z = random.Between(1, side);
+
+		if(cubes.insert((x * (side + 1) + y) * (side + 1) + z).second) {
+			output << x << ',' << y << ',' << z << '\n';
+		}
+	}
+}
+
+// The search of the first three blueprints over 32 minutes grows exponentially as robots get cheaper: with
+// every cost as low as the puzzle allows some single blueprints run for many minutes. The costs stay in the
+// expensive part of the puzzle's range, where each of the three takes seconds, about as long as with the
+// puzzle's own input, and the 24 minute search of every blueprint a few milliseconds.
+void generateDay19(std::ostream& output, Random& random, long long scale) {
+	for(long long blueprint = 1; blueprint <= scale; ++blueprint) {
+		output << "Blueprint " << blueprint << ": ";
+		output << "Each ore robot costs " << random.Between(3, 4) << " ore. ";
+		output << "Each clay robot costs 4 ore. ";
+		output << "Each obsidian robot costs " << random.Between(3, 4) << " ore and " << random.Between(14, 20) << " clay. ";
+		output << "Each geode robot costs " << random.Between(2, 4) << " ore and " << random.Between(12, 20) << " obsidian.\n";
+	}
+}
+
+void generateDay20(std::ostream& output, Random& random, long long scale) {
+	long long const zeroIndex = random.Between(0, std::max(0LL, scale - 1));
+
+	for(long long i = 0; i < scale; ++i) {
+		long long value = 0;
+
+		while(i != zeroIndex && value == 0) {
+			value = random.Between(-10000, 10000);
+		}
+
+		output << value << '\n';
+	}
+}
+
+class MonkeyTreeWriter {
+public:
+	MonkeyTreeWriter(std::ostream& output, Random& random, std::vector<std::string>&& names) :
+		Output(output),
+		RandomSource(random),
+		Names(std::move(names))
+	{}
+
+	std::string NextName() {
+		[[unlikely]]
+		if(NextNameIdx >= Names.size()) {
+			aoc::crash("Ran out of monkey names");
+		}
+
+		return Names[NextNameIdx++];
+	}
+
+	// Writes `nodes` monkeys (an odd number) that yell `value`, every division is exact.
+	std::string WriteValue(long long value, long long nodes) {
+		auto const name = NextName();
+
+		if(nodes < 3) {
+			Output << name << ": " << value << '\n';
+			return name;
+		}
+
+		long long const leftNodes = 2 * RandomSource.Between(0, (nodes - 3) / 2) + 1;
+		long long const rightNodes = nodes - 1 - leftNodes;
+
+		long long left, right;
+		char operation;
+
+		auto const divisor = RandomSource.Between(2, 9);
+		auto const choice = RandomSource.Between(0, 3);
+
+		if(choice == 0 && value >= 2) {
+			operation = '+';
+			left = RandomSource.Between(1, value - 1);
+			right = value - left;
+		}
+		else if(choice == 1 && value % divisor == 0) {
+			operation = '*';
+			left = value / divisor;
+			right = divisor;
+		}
+		else if(choice == 2 && value < 1000000000) {
+			operation = '/';
+			left = value * divisor;
+			right = divisor;
+		}
+		else {
+			operation = '-';
+			right = RandomSource.Between(1, 1000);
+			left = value + right;
+		}
+
+		auto const leftName = WriteValue(left, leftNodes);
+		auto const rightName = WriteValue(right, rightNodes);
+
+		Output << name << ": " << leftName << ' ' << operation << ' ' << rightName << '\n';
+
+		return name;
+	}
+
+	std::ostream& Output;
+	Random& RandomSource;
+	std::vector<std::string> Names;
+	std::size_t NextNameIdx{ 0 };
+};
+
+// A tree of monkeys with humn on one side of root. Only +, - and * sit between humn and root, and the
+// other side of root is built to match what that path yields for a chosen humn, so part 2 is exact.
+void generateDay21(std::ostream& output, Random& random, long long scale) {
+	long long const nodes = scale;
+
+	MonkeyTreeWriter writer(output, random, makeNames(random, nodes, 4, { "root", "humn" }));
+
+	long long const pathLength = std::min(60LL, nodes / 4);
+	long long const sideNodes = (nodes - 2 - 2 * pathLength) / (pathLength + 1) / 2 * 2 + 1;
+
+	long long const humanValue = random.Between(1, 1000);
+	long long const answerValue = random.Between(1, 1000);
+
+	output << "humn: " << humanValue << '\n';
+
+	std::string pathName = "humn";
+	long long pathValue = answerValue;
+	int multiplications = 0;
+
+	for(long long step = 0; step < pathLength; ++step) {
+		auto const choice = random.Between(0, 3);
+		bool const isPathLeft = random.Chance(0.5);
+
+		long long constant;
+		char operation;
+
+		if(choice == 0 && multiplications < 12) {
+			operation = '*';
+			constant = random.Between(2, 4);
+			pathValue *= constant;
+			++multiplications;
+		}
+		else if(choice == 1 && isPathLeft && pathValue > 1) {
+			operation = '-';
+			constant = random.Between(1, pathValue - 1);
+			pathValue -= constant;
+		}
+		else if(choice == 1 && !isPathLeft) {
+			operation = '-';
+			constant = pathValue + random.Between(1, 1000);
+			pathValue = constant - pathValue;
+		}
+		else {
+			operation = '+';
+			constant = random.Between(1, 1000);
+			pathValue += constant;
+		}
+
+		auto const constantName = writer.WriteValue(constant, sideNodes);
+		auto const name = writer.NextName();
+
+		output << name << ": " << (isPathLeft ? pathName : constantName) << ' ' << operation << ' ' << (isPathLeft ? constantName : pathName) << '\n';
+
+		pathName = name;
+	}
+
+	auto const otherName = writer.WriteValue(pathValue, sideNodes);
+
+	if(random.Chance(0.5)) {
+		output << "root: " << pathName << " + " << otherName << '\n';
+	}
+	else {
+		output << "root: " << otherName << " + " << pathName << '\n';
+	}
+}
+
+constexpr std::array generators{
+	Generator{ "02", 1000000, "rounds", &generateDay02 },
+	Generator{ "03", 1000000, "rucksacks", &generateDay03 },
+	Generator{ "04", 1000000, "pairs", &generateDay04 },
+	Generator{ "05", 1000000, "moves", &generateDay05 },
+	Generator{ "06", 10000000, "signal characters", &generateDay06 },
+	Generator{ "07", 1000000, "files", &generateDay07 },
+	Generator{ "08", 2000, "grid side", &generateDay08 },
+	Generator{ "09", 1000000, "moves", &generateDay09 },
+	Generator{ "10", 1000000, "instructions", &generateDay10 },
+	// every monkey throws to others
+	Generator{ "11", 100, "monkeys", &generateDay11, 2 },
+	Generator{ "12", 1000, "grid side", &generateDay12, 26 },
+	Generator{ "13", 100000, "packet pairs", &generateDay13 },
+	Generator{ "14", 10000, "rock paths", &generateDay14 },
+	// the four sensors that box in the hidden beacon
+	Generator{ "15", 100000, "sensors", &generateDay15, 4 },
+	Generator{ "16", 40, "valves with flow", &generateDay16, 1, day16FlowValveLimit },
+	Generator{ "17", 10000000, "jets", &generateDay17 },
+	Generator{ "18", 100000, "cubes", &generateDay18 },
+	Generator{ "19", 100, "blueprints", &generateDay19 },
+	// mixing needs a 0 and another number
+	Generator{ "20", 100000, "numbers", &generateDay20, 2 },
+	// root, humn and a path between them; four lowercase letters leave room for 456976 names
+	Generator{ "21", 100000, "monkeys", &generateDay21, 9, 400000 },
+};
+
+constexpr std::string_view usage = "Usage: generator <day> [--scale <n>] [--seed <n>] [--output <file>]";
+
+std::optional<long long> parseNumber(std::string_view text) {
+	long long value{};
+	auto const [end, error] = std::from_chars(text.data(), text.data() + text.size(), value);
+
+	if(error != std::errc{} || end != text.data() + text.size() || value < 0) {
+		return std::nullopt;
+	}
+
+	return value;
+}
+
+int main(int argc, char** argv) {
+	std::vector<std::string_view> const args(argv + 1, argv + argc);
+
+	if(!args.empty() && args.front() == "--list") {
+		for(auto const& generator : generators) {
+			std::cout << generator.Day << "\tscale = " << generator.ScaleMeaning << " (default " << generator.DefaultScale << ", at least " << generator.MinScale;
+
+			if(generator.MaxScale != std::numeric_limits<long long>::max()) {
+				std::cout << ", at most " << generator.MaxScale;
+			}
+
+			std::cout << ")\n";
+		}
+
+		return 0;
+	}
+
+	[[unlikely]]
+	if(args.empty()) {
+		return aoc::failUsage(usage, "Expected a day or --list");
+	}
+
+	auto const day = args.front().size() == 1 ? "0" + std::string(args.front()) : std::string(args.front());
+
+	auto const generator = std::find_if(generators.begin(), generators.end(), [&day](Generator const& generator) {
+		return generator.Day == day;
+	});
+
+	[[unlikely]]
+	if(generator == generators.end()) {
+		return aoc::failUsage(usage, "No generator for day " + day);
+	}
+
+	long long scale = generator->DefaultScale;
+	unsigned long long seed = 2022;
+	std::string outputPath;
+
+	for(std::size_t i = 1; i < args.size(); ++i) {
+		auto const arg = args[i];
+
+		[[unlikely]]
+		if(i + 1 >= args.size()) {
+			return aoc::failUsage(usage, std::string(arg) + " expects a value");
+		}
+
+		auto const value = args[++i];
+
+		if(arg == "--output") {
+			outputPath = value;
+			continue;
+		}
+
+		[[unlikely]]
+		if(arg != "--scale" && arg != "--seed") {
+			return aoc::failUsage(usage, "Unknown option " + std::string(arg));
+		}
+
+		auto const number = parseNumber(value);
+
+		[[unlikely]]
+		if(!number) {
+			return aoc::failUsage(usage, std::string(arg) + " expects a non-negative number, got " + std::string(value));
+		}
+
+		if(arg == "--scale") {
+			[[unlikely]]
+			if(*number < generator->MinScale) {
+				return aoc::failUsage(usage, "--scale for day " + day + " is at least " + std::to_string(generator->MinScale) + ", got " + std::string(value));
+			}
+
+			[[unlikely]]
+			if(*number > generator->MaxScale) {
+				return aoc::failUsage(usage, "--scale for day " + day + " is at most " + std::to_string(generator->MaxScale) + ", got " + std::string(value));
+			}
+
+			scale = *number;
+		}
+		else {
+			seed = (unsigned long long)(*number);
+		}
+	}
+
+	Random random(seed);
+
+	if(outputPath.empty()) {
+		std::ios::sync_with_stdio(false);
+		generator->Generate(std::cout, random, scale);
+		std::cout.flush();
+	}
+	else {
+		std::ofstream output(outputPath, std::ios::binary);
+
+		[[unlikely]]
+		if(!output) {
+			std::cerr << "Could not open " << outputPath << '\n';
+			return 1;
+		}
+
+		generator->Generate(output, random, scale);
+	}
+
+	return 0;
+}